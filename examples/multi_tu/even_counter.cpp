@@ -10,7 +10,7 @@
  * SPDX-License-Identifier: BSD-3-Clause.
  *
  * Created on : 2026-07-27 by ceandrade.
- * Last update: 2026-07-27 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
  *****************************************************************************/
 
 #include "even_counter.hpp"
@@ -19,7 +19,6 @@
 
 #include <iostream>
 #include <random>
-#include <thread>
 
 using namespace std::chrono_literals;
 
@@ -42,7 +41,8 @@ std::size_t countEvenNumbers() {
         << ", elapsed = " << cea::ExecutionStopper::elapsed().count() << "s"
         << std::endl;
 
-        std::this_thread::sleep_for(500ms);
+        // Pause, but wake up right away when the deadline expires.
+        cea::ExecutionStopper::waitFor(500ms);
     }
 
     return evens;
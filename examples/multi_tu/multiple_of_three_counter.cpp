@@ -11,7 +11,7 @@
  * SPDX-License-Identifier: BSD-3-Clause.
  *
  * Created on : 2026-07-27 by ceandrade.
- * Last update: 2026-07-27 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
  *****************************************************************************/
 
 #include "multiple_of_three_counter.hpp"
@@ -20,7 +20,6 @@
 
 #include <iostream>
 #include <random>
-#include <thread>
 
 using namespace std::chrono_literals;
 
@@ -42,7 +41,8 @@ std::size_t countMultiplesOfThree() {
         << ", elapsed = " << cea::ExecutionStopper::elapsed().count() << "s"
         << std::endl;
 
-        std::this_thread::sleep_for(700ms);
+        // Pause, but wake up right away when the deadline expires.
+        cea::ExecutionStopper::waitFor(700ms);
     }
 
     return multiples;
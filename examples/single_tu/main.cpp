@@ -10,14 +10,13 @@
  * SPDX-License-Identifier: BSD-3-Clause.
  *
  * Created on : 2026-07-27 by ceandrade.
- * Last update: 2026-07-27 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
  *****************************************************************************/
 
 #include "timer/execution_stopper.hpp"
 
 #include <chrono>
 #include <iostream>
-#include <thread>
 
 using namespace std::chrono_literals;
 
@@ -33,7 +32,8 @@ int main() {
         std::cout
         << "Elapsed: " << ExecutionStopper::elapsed().count() << "s"
         << std::endl;
-        std::this_thread::sleep_for(1s);
+        // Wait one second, but wake up right away on expiration or Ctrl-C.
+        ExecutionStopper::waitFor(1s);
     }
 
     std::cout
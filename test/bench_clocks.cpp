@@ -0,0 +1,88 @@
+/******************************************************************************
+ * @file bench_clocks.cpp
+ * @brief Benchmark of the BasicTimer clock policies.
+ *
+ * Measures the average cost of `start()`, `stop()`/`resume()`, and
+ * `elapsedInNanoseconds()` for each available clock policy.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/clocks.hpp"
+#include "timer/timer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Number of operations per measurement.
+static constexpr std::int64_t NUM_OPERATIONS = 10'000'000;
+
+// Keeps the compiler from discarding the measured results.
+static volatile std::int64_t sink = 0;
+
+// Runs `operation` NUM_OPERATIONS times and returns the cost per call.
+template <class Operation>
+double costPerCall(Operation&& operation) {
+    const auto begin = steady_clock::now();
+    for(std::int64_t i = 0; i < NUM_OPERATIONS; ++i)
+        operation();
+    const auto end = steady_clock::now();
+    return static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+           / NUM_OPERATIONS;
+}
+
+template <class Clock>
+void benchmarkClock(const char* name) {
+    cea::BasicTimer<Clock> timer;
+
+    const double start_cost = costPerCall([&] { timer.start(); });
+
+    timer.start();
+    const double stop_resume_cost = costPerCall([&] {
+        timer.stop();
+        timer.resume();
+    });
+
+    const double elapsed_cost = costPerCall([&] {
+        sink = sink + timer.elapsedInNanoseconds().count();
+    });
+
+    cout
+    << left << setw(24) << name << right << fixed << setprecision(2)
+    << setw(12) << start_cost
+    << setw(16) << stop_resume_cost
+    << setw(14) << elapsed_cost
+    << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout
+    << "Cost per call in nanoseconds (" << NUM_OPERATIONS << " calls)\n\n"
+    << left << setw(24) << "Clock" << right
+    << setw(12) << "start()"
+    << setw(16) << "stop()+resume()"
+    << setw(14) << "elapsedInNs()"
+    << endl;
+
+    benchmarkClock<steady_clock>("steady_clock");
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    benchmarkClock<cea::MonotonicCoarseClock>("MonotonicCoarseClock");
+    benchmarkClock<cea::MonotonicRawClock>("MonotonicRawClock");
+    #endif
+    benchmarkClock<cea::TscClock>(
+        cea::TscClock::isInvariant()? "TscClock" : "TscClock (fallback)");
+    return 0;
+}
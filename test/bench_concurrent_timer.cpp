@@ -0,0 +1,119 @@
+/******************************************************************************
+ * @file bench_concurrent_timer.cpp
+ * @brief Benchmark of the BasicConcurrentTimer reads.
+ *
+ * Measures the throughput of `elapsedInNanoseconds()` from 1 to N reader
+ * threads, with an idle controller and with a controller toggling
+ * `stop()`/`resume()` as fast as it can. The unsynchronized BasicTimer read
+ * from a single thread is the baseline.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/concurrent_timer.hpp"
+#include "timer/timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Duration of each measurement.
+static constexpr auto MEASUREMENT_TIME = 300ms;
+
+// Keeps the compiler from discarding the measured results.
+static std::atomic<std::int64_t> sink {0};
+
+// Runs `read` in `num_readers` threads for MEASUREMENT_TIME, optionally
+// toggling the timer in the meantime, and returns the reads per second.
+template <class Timer>
+double readsPerSecond(Timer& timer, unsigned num_readers, bool toggle) {
+    std::atomic<bool> go {false}, done {false};
+    std::atomic<std::int64_t> num_reads {0};
+
+    std::vector<std::thread> readers;
+    for(unsigned i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&] {
+            while(!go.load(std::memory_order_acquire)) {}
+            std::int64_t reads = 0, total = 0;
+            while(!done.load(std::memory_order_relaxed)) {
+                total += timer.elapsedInNanoseconds().count();
+                ++reads;
+            }
+            num_reads += reads;
+            sink += total;
+        });
+    }
+
+    go.store(true, std::memory_order_release);
+    const auto begin = steady_clock::now();
+    if(toggle) {
+        while(steady_clock::now() - begin < MEASUREMENT_TIME) {
+            timer.stop();
+            timer.resume();
+        }
+    }
+    else {
+        std::this_thread::sleep_for(MEASUREMENT_TIME);
+    }
+    done.store(true);
+    const auto end = steady_clock::now();
+    for(auto& reader : readers)
+        reader.join();
+
+    return static_cast<double>(num_reads.load()) /
+           duration_cast<duration<double>>(end - begin).count();
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    const auto max_readers = std::max(1u, std::thread::hardware_concurrency());
+
+    cea::Timer plain_timer;
+    plain_timer.start();
+    const double baseline = readsPerSecond(plain_timer, 1, false);
+    cout
+    << "Baseline: BasicTimer, 1 reader, no controller: "
+    << fixed << setprecision(2) << baseline / 1e6 << " M reads/s\n\n";
+
+    cout
+    << "ConcurrentTimer reads (M reads/s, and ns per read per thread)\n\n"
+    << right
+    << setw(8) << "Readers"
+    << setw(14) << "Idle"
+    << setw(10) << "ns/read"
+    << setw(14) << "Toggling"
+    << setw(10) << "ns/read"
+    << endl;
+
+    cea::ConcurrentTimer timer;
+    timer.start();
+    for(unsigned num_readers = 1; num_readers <= max_readers;
+        num_readers *= 2) {
+        const double idle = readsPerSecond(timer, num_readers, false);
+        const double toggling = readsPerSecond(timer, num_readers, true);
+        cout
+        << setw(8) << num_readers << fixed << setprecision(2)
+        << setw(14) << idle / 1e6
+        << setw(10) << num_readers * 1e9 / idle
+        << setw(14) << toggling / 1e6
+        << setw(10) << num_readers * 1e9 / toggling
+        << endl;
+    }
+    return 0;
+}
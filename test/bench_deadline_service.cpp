@@ -0,0 +1,139 @@
+/******************************************************************************
+ * @file bench_deadline_service.cpp
+ * @brief Scaling benchmark of the DeadlineService timing wheel.
+ *
+ * Schedules from 1 to 100k concurrent deadlines on the single service thread
+ * and reports the cost of scheduling and cancelling, and the expiry latency
+ * (time between the deadline and the callback) and its jitter.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/deadline_service.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-----------------------------[ Probe deadline ]-----------------------------//
+
+// Records when the service fired it.
+struct ProbeNode: public cea::DeadlineNode {
+    std::int64_t deadline {0};
+    std::int64_t fired_at {0};
+    std::atomic<std::size_t>* fired_count {nullptr};
+
+    void onDeadline() noexcept override {
+        fired_at = cea::DeadlineService::now();
+        fired_count->fetch_add(1, std::memory_order_release);
+    }
+};
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+void benchmark(std::size_t num_deadlines, std::mt19937_64& rng) {
+    auto& service = cea::DeadlineService::instance();
+    std::atomic<std::size_t> fired_count {0};
+    std::vector<ProbeNode> nodes(num_deadlines);
+    for(auto& node : nodes)
+        node.fired_count = &fired_count;
+
+    // Scheduling and cancelling cost, far in the future.
+    auto begin = cea::DeadlineService::now();
+    for(auto& node : nodes)
+        service.schedule(node, begin + 3'600'000'000'000);
+    const auto schedule_cost =
+        static_cast<double>(cea::DeadlineService::now() - begin) /
+        static_cast<double>(num_deadlines);
+
+    begin = cea::DeadlineService::now();
+    for(auto& node : nodes)
+        service.cancel(node);
+    const auto cancel_cost =
+        static_cast<double>(cea::DeadlineService::now() - begin) /
+        static_cast<double>(num_deadlines);
+
+    // Expiry latency: deadlines spread over 20 to 120 ms from now.
+    std::uniform_int_distribution<std::int64_t> spread {20'000'000,
+                                                        120'000'000};
+    const auto now = cea::DeadlineService::now();
+    for(auto& node : nodes) {
+        node.deadline = now + spread(rng);
+        service.schedule(node, node.deadline);
+    }
+    while(fired_count.load(std::memory_order_acquire) < num_deadlines)
+        std::this_thread::sleep_for(5ms);
+
+    std::vector<double> latencies;
+    latencies.reserve(num_deadlines);
+    for(const auto& node : nodes)
+        latencies.push_back(static_cast<double>(node.fired_at - node.deadline)
+                            / 1e3);
+    std::sort(latencies.begin(), latencies.end());
+
+    double mean = 0.0;
+    for(const auto latency : latencies)
+        mean += latency;
+    mean /= static_cast<double>(num_deadlines);
+    double variance = 0.0;
+    for(const auto latency : latencies)
+        variance += (latency - mean) * (latency - mean);
+    const double jitter =
+        std::sqrt(variance / static_cast<double>(num_deadlines));
+
+    const auto percentile = [&](double p) {
+        return latencies[static_cast<std::size_t>(
+            p * static_cast<double>(num_deadlines - 1))];
+    };
+
+    cout
+    << right << fixed << setprecision(1)
+    << setw(9) << num_deadlines
+    << setw(12) << schedule_cost
+    << setw(12) << cancel_cost
+    << setw(11) << mean
+    << setw(11) << percentile(0.50)
+    << setw(11) << percentile(0.99)
+    << setw(11) << latencies.back()
+    << setw(11) << jitter
+    << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    std::mt19937_64 rng {2026};
+
+    cout
+    << "DeadlineService scaling (tick = "
+    << cea::DeadlineService::tick / 1000 << " us)\n"
+    << "Schedule/cancel costs in ns per operation; "
+    << "expiry latencies and jitter (stddev) in us\n\n"
+    << setw(9) << "deadlines"
+    << setw(12) << "schedule"
+    << setw(12) << "cancel"
+    << setw(11) << "mean"
+    << setw(11) << "p50"
+    << setw(11) << "p99"
+    << setw(11) << "max"
+    << setw(11) << "jitter"
+    << endl;
+
+    for(std::size_t n = 1; n <= 100'000; n *= 10)
+        benchmark(n, rng);
+    return 0;
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * @file bench_execution_stopper.cpp
+ * @brief Benchmark of the ExecutionStopper deadline updates.
+ *
+ * Compares the latency of `setExpirationTime()` on the persistent watchdog
+ * against the former design, which cancelled and joined the watchdog thread
+ * and spawned a new one on every deadline change.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/execution_stopper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------[ Former watchdog design ]-------------------------//
+
+// Replica of the former ExecutionStopper::spawnWatchdog(): every deadline
+// change cancels and joins the watchdog thread, then spawns a new one.
+class RespawningWatchdog {
+public:
+    RespawningWatchdog() = default;
+
+    ~RespawningWatchdog() { cancel(); }
+
+    void setExpirationTime(nanoseconds remaining) {
+        cancel();
+        cancelled.store(false, std::memory_order_relaxed);
+        watchdog = std::thread {[this, remaining] {
+            std::unique_lock lock(mutex);
+            const bool was_cancelled = cv.wait_for(lock, remaining, [this] {
+                return cancelled.load(std::memory_order_relaxed);
+            });
+            if(!was_cancelled)
+                expired.store(true, std::memory_order_relaxed);
+        }};
+    }
+
+private:
+    void cancel() {
+        cancelled.store(true, std::memory_order_relaxed);
+        cv.notify_all();
+        if(watchdog.joinable())
+            watchdog.join();
+    }
+
+    std::mutex mutex {};
+    std::condition_variable_any cv {};
+    std::atomic<bool> cancelled {false};
+    std::atomic<bool> expired {false};
+    std::thread watchdog {};
+};
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+static constexpr int NUM_UPDATES = 10'000;
+
+// Runs `update(i)` NUM_UPDATES times and reports latency statistics.
+template <class Update>
+void report(const char* name, Update&& update) {
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(NUM_UPDATES);
+    for(int i = 0; i < NUM_UPDATES; ++i) {
+        const auto begin = steady_clock::now();
+        update(i);
+        const auto end = steady_clock::now();
+        latencies.push_back(duration_cast<nanoseconds>(end - begin).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    const auto percentile = [&](double p) {
+        return latencies[static_cast<std::size_t>(p * (NUM_UPDATES - 1))];
+    };
+
+    cout
+    << left << setw(34) << name << right
+    << setw(12) << percentile(0.50)
+    << setw(12) << percentile(0.99)
+    << setw(12) << latencies.back()
+    << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    using exec = cea::ExecutionStopper;
+
+    cout
+    << "setExpirationTime() latency in nanoseconds ("
+    << NUM_UPDATES << " updates)\n\n"
+    << left << setw(34) << "Design" << right
+    << setw(12) << "p50" << setw(12) << "p99" << setw(12) << "max"
+    << endl;
+
+    RespawningWatchdog respawning;
+    report("respawn (former)", [&](int i) {
+        respawning.setExpirationTime(seconds {100 + i % 2});
+    });
+
+    exec::setExpirationTime(100s);
+    exec::start();
+
+    report("persistent, extending", [](int i) {
+        exec::setExpirationTime(seconds {100 + i});
+    });
+
+    report("persistent, alternating", [](int i) {
+        exec::setExpirationTime(seconds {100 + i % 2});
+    });
+
+    exec::stop();
+    return 0;
+}
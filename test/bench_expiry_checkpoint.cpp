@@ -0,0 +1,116 @@
+/******************************************************************************
+ * @file bench_expiry_checkpoint.cpp
+ * @brief Benchmark of the BasicExpiryCheckpoint class.
+ *
+ * Measures the throughput of a vectorizable loop (y = a * x + y) when it
+ * checks the ExecutionStopper on every iteration, against checking it
+ * through an ExpiryCheckpoint with a fixed and an adaptive interval.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/benchmark.hpp"
+#include "timer/execution_stopper.hpp"
+#include "timer/expiry_checkpoint.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Size of the arrays; small enough to stay in the L1/L2 caches.
+static constexpr std::size_t SIZE = 4096;
+
+// Passes over the arrays per measurement.
+static constexpr int NUM_PASSES = 50'000;
+
+// Runs `pass` NUM_PASSES times and prints the average cost per element,
+// relative to `baseline` (if not zero). Returns the cost.
+template <class Pass>
+double measure(const std::string& name, double baseline, Pass pass) {
+    const auto begin = steady_clock::now();
+    for(int i = 0; i < NUM_PASSES; ++i)
+        pass();
+    const auto end = steady_clock::now();
+    const double cost =
+        static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+        / (static_cast<double>(NUM_PASSES) * SIZE);
+
+    cout << left << setw(40) << name << right << fixed
+         << setprecision(3) << setw(10) << cost << " ns";
+    if(baseline > 0.0)
+        cout << setprecision(2) << setw(10) << cost / baseline << "x";
+    cout << endl;
+    return cost;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    using exec = cea::ExecutionStopper;
+    exec::setExpirationTime(3600s);
+    exec::start();
+
+    std::vector<float> x(SIZE, 1.0f), y(SIZE, 0.0f);
+    const float a = 0.5f;
+    float* __restrict out = y.data();
+    const float* __restrict in = x.data();
+
+    cout << "Average cost per element of y = a * x + y ("
+         << SIZE << " floats)\n\n";
+
+    const double baseline = measure("no check", 0.0, [&] {
+        for(std::size_t i = 0; i < SIZE; ++i)
+            out[i] = a * in[i] + out[i];
+        cea::doNotOptimize(out[0]);
+    });
+
+    measure("isExpired() on every iteration", baseline, [&] {
+        for(std::size_t i = 0; i < SIZE; ++i) {
+            if(exec::isExpired())
+                break;
+            out[i] = a * in[i] + out[i];
+        }
+        cea::doNotOptimize(out[0]);
+    });
+
+    cea::BasicExpiryCheckpoint<cea::TscClock, 1024> fixed_checkpoint;
+    measure("checkpoint isExpired(), 1 in 1024", baseline, [&] {
+        for(std::size_t i = 0; i < SIZE; ++i) {
+            if(fixed_checkpoint.isExpired())
+                break;
+            out[i] = a * in[i] + out[i];
+        }
+        cea::doNotOptimize(out[0]);
+    });
+
+    measure("checkpoint forEach(), 1 in 1024", baseline, [&] {
+        fixed_checkpoint.forEach(std::size_t {0}, SIZE,
+            [&](std::size_t i) { out[i] = a * in[i] + out[i]; });
+        cea::doNotOptimize(out[0]);
+    });
+
+    cea::ExpiryCheckpoint adaptive_checkpoint;
+    measure("checkpoint forEach(), adaptive 1 ms", baseline, [&] {
+        adaptive_checkpoint.forEach(std::size_t {0}, SIZE,
+            [&](std::size_t i) { out[i] = a * in[i] + out[i]; });
+        cea::doNotOptimize(out[0]);
+    });
+
+    cout << "\nAdaptive interval: " << adaptive_checkpoint.interval()
+         << " iterations" << endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * @file bench_hot_flag.cpp
+ * @brief Contention benchmark of the expiration flag and the elapsed time.
+ *
+ * From 1 to 128 reader threads, measures the cost of:
+ * - checking a flag sharing its cache line with a field written by a
+ *   controller thread (the former StopScope layout), against a flag on its
+ *   own cache line (the current layout);
+ * - `StopScope::isExpired()`, `elapsedInNanoseconds()`, and `elapsedApprox()`
+ *   while the controller keeps stopping and resuming the scope.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/stop_scope.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Layouts ]----------------------------------//
+
+// The flag next to a field the controller writes, as before.
+struct SharedLine {
+    std::atomic<bool> flag {false};
+    std::atomic<std::int64_t> written {0};
+};
+
+// The flag on its own cache line.
+struct IsolatedLine {
+    alignas(cea::cache_line_size) std::atomic<bool> flag {false};
+    alignas(cea::cache_line_size) std::atomic<std::int64_t> written {0};
+};
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Duration of each measurement.
+static constexpr auto MEASUREMENT_TIME = 100ms;
+
+// Keeps the compiler from discarding the measured results.
+static std::atomic<std::int64_t> sink {0};
+
+// Runs `read` in `num_readers` threads for MEASUREMENT_TIME, while the
+// calling thread runs `write` in a loop. Returns the average cost of a read
+// in nanoseconds, per thread.
+template <class Read, class Write>
+double nsPerRead(unsigned num_readers, Read read, Write write) {
+    std::atomic<bool> go {false}, done {false};
+    std::atomic<std::int64_t> num_reads {0};
+
+    std::vector<std::thread> readers;
+    for(unsigned i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&] {
+            while(!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            std::int64_t reads = 0, total = 0;
+            while(!done.load(std::memory_order_relaxed)) {
+                // Unrolled, so the loop control does not dominate.
+                for(int j = 0; j < 16; ++j)
+                    total += read();
+                reads += 16;
+            }
+            num_reads += reads;
+            sink += total;
+        });
+    }
+
+    go.store(true, std::memory_order_release);
+    const auto begin = steady_clock::now();
+    while(steady_clock::now() - begin < MEASUREMENT_TIME)
+        write();
+    done.store(true);
+    const auto end = steady_clock::now();
+    for(auto& reader : readers)
+        reader.join();
+
+    return num_readers *
+           static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+           / static_cast<double>(num_reads.load());
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    SharedLine shared;
+    IsolatedLine isolated;
+
+    cea::StopScope scope;
+    scope.start();
+    scope.elapsedApprox();  // Starts the coarse updates.
+
+    cout
+    << "Cost per read in nanoseconds, per thread, while a controller writes\n"
+    << "(" << std::thread::hardware_concurrency() << " hardware threads; "
+    << "beyond that, readers are oversubscribed)\n\n"
+    << right
+    << setw(8) << "Readers"
+    << setw(12) << "shared"
+    << setw(12) << "isolated"
+    << setw(12) << "isExpired"
+    << setw(12) << "elapsedNs"
+    << setw(12) << "approx"
+    << endl;
+
+    for(unsigned num_readers = 1; num_readers <= 128; num_readers *= 2) {
+        const double shared_cost = nsPerRead(num_readers,
+            [&] { return shared.flag.load(relaxed)? 1 : 0; },
+            [&] { shared.written.fetch_add(1, relaxed); });
+
+        const double isolated_cost = nsPerRead(num_readers,
+            [&] { return isolated.flag.load(relaxed)? 1 : 0; },
+            [&] { isolated.written.fetch_add(1, relaxed); });
+
+        const auto toggle = [&] {
+            scope.stop();
+            scope.resume();
+        };
+
+        const double expired_cost = nsPerRead(num_readers,
+            [&] { return scope.isExpired()? 1 : 0; }, toggle);
+
+        const double elapsed_cost = nsPerRead(num_readers,
+            [&] { return scope.elapsedInNanoseconds().count(); }, toggle);
+
+        const double approx_cost = nsPerRead(num_readers,
+            [&] { return scope.elapsedApprox().count(); }, toggle);
+
+        cout
+        << setw(8) << num_readers << fixed << setprecision(2)
+        << setw(12) << shared_cost
+        << setw(12) << isolated_cost
+        << setw(12) << expired_cost
+        << setw(12) << elapsed_cost
+        << setw(12) << approx_cost
+        << endl;
+    }
+    return 0;
+}
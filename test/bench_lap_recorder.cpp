@@ -0,0 +1,88 @@
+/******************************************************************************
+ * @file bench_lap_recorder.cpp
+ * @brief Benchmark of the BasicLapRecorder class.
+ *
+ * Compares the cost of a lap, with each overflow policy, against pushing the
+ * elapsed time of a Timer into a std::vector, and measures the
+ * post-processing of the laps.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/lap_recorder.hpp"
+#include "timer/timer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Keeps the compiler from discarding the measured results.
+static volatile std::int64_t sink = 0;
+
+// Runs `operation` `iterations` times and prints the average cost.
+template <class Operation>
+void measure(const std::string& name, std::int64_t iterations,
+             Operation operation) {
+    const auto begin = steady_clock::now();
+    for(std::int64_t i = 0; i < iterations; ++i)
+        operation();
+    const auto end = steady_clock::now();
+    cout << left << setw(36) << name << right << fixed << setprecision(2)
+         << setw(12)
+         << static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+            / static_cast<double>(iterations)
+         << " ns" << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    constexpr std::int64_t num_laps = 10'000'000;
+    constexpr std::size_t capacity = 1'000'000;
+
+    cout << "Average cost per lap (" << num_laps << " laps, arena of "
+         << capacity << ")\n\n";
+
+    cea::Timer timer;
+    timer.start();
+    std::vector<std::int64_t> splits;
+    measure("Timer into std::vector", num_laps, [&] {
+        splits.push_back(timer.elapsedInNanoseconds().count());
+    });
+
+    const std::pair<const char*, cea::LapOverflow> policies[] {
+        {"lap(), ring", cea::LapOverflow::ring},
+        {"lap(), drop", cea::LapOverflow::drop},
+        {"lap(), sampled", cea::LapOverflow::sampled}
+    };
+    for(const auto& [name, overflow] : policies) {
+        cea::LapRecorder laps(capacity, overflow);
+        laps.start();
+        measure(name, num_laps, [&laps] {
+            sink = laps.lap().count();
+        });
+    }
+
+    cea::LapRecorder laps(capacity, cea::LapOverflow::ring);
+    laps.start();
+    for(std::size_t i = 0; i < capacity; ++i)
+        laps.lap();
+    cout << "\nAverage cost per call, with a full arena\n\n";
+    measure("summary()", 100, [&laps] {
+        sink = laps.summary().max.count();
+    });
+    return 0;
+}
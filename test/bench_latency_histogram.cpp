@@ -0,0 +1,81 @@
+/******************************************************************************
+ * @file bench_latency_histogram.cpp
+ * @brief Benchmark of the LatencyHistogram class.
+ *
+ * Measures the cost of recording a sample, of recording a timer reading
+ * (clock read included), of merging two histograms, and of a percentile
+ * query.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/latency_histogram.hpp"
+#include "timer/timer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace std::chrono;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Keeps the compiler from discarding the measured results.
+static volatile std::int64_t sink = 0;
+
+// Runs `operation` `iterations` times and prints the average cost.
+template <class Operation>
+void measure(const std::string& name, std::int64_t iterations,
+             Operation operation) {
+    const auto begin = steady_clock::now();
+    for(std::int64_t i = 0; i < iterations; ++i)
+        operation(i);
+    const auto end = steady_clock::now();
+    cout << left << setw(36) << name << right << fixed << setprecision(2)
+         << setw(12)
+         << static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+            / static_cast<double>(iterations)
+         << " ns" << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    auto histogram = std::make_unique<cea::LatencyHistogram>();
+    auto other = std::make_unique<cea::LatencyHistogram>();
+    cea::Timer timer;
+    timer.start();
+
+    cout << "Average cost per operation (histogram of "
+         << sizeof(cea::LatencyHistogram) / 1024 << " KB)\n\n";
+
+    measure("record(nanoseconds)", 50'000'000, [&](std::int64_t i) {
+        // Spread over several magnitudes, as real latencies are.
+        histogram->record(nanoseconds {(i * 2654435761) & 0xFFFFFF});
+    });
+
+    measure("recordElapsed(Timer)", 20'000'000, [&](std::int64_t) {
+        histogram->recordElapsed(timer);
+    });
+
+    other->merge(*histogram);
+    measure("merge()", 10'000, [&](std::int64_t) {
+        other->merge(*histogram);
+    });
+
+    measure("valueAtPercentile(99.9)", 10'000, [&](std::int64_t) {
+        sink = histogram->valueAtPercentile(99.9).count();
+    });
+
+    cout << '\n';
+    histogram->printSummary(cout);
+    return 0;
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * @file bench_perf_counters.cpp
+ * @brief Benchmark of the PerfCounters and PerfTimer classes.
+ *
+ * Measures the cost of reading the counters of the calling thread (with
+ * rdpmc or read(), whichever the machine allows), and of a PerfTimer
+ * start/stop pair, against a plain Timer.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/perf_counters.hpp"
+#include "timer/timer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace std::chrono;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Keeps the compiler from discarding the measured results.
+static volatile std::uint64_t sink = 0;
+
+// Runs `operation` `iterations` times and prints the average cost.
+template <class Operation>
+void measure(const std::string& name, std::int64_t iterations,
+             Operation operation) {
+    const auto begin = steady_clock::now();
+    for(std::int64_t i = 0; i < iterations; ++i)
+        operation();
+    const auto end = steady_clock::now();
+    cout << left << setw(36) << name << right << fixed << setprecision(2)
+         << setw(12)
+         << static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+            / static_cast<double>(iterations)
+         << " ns" << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    const auto& counters = cea::PerfCounters::forThread();
+    const auto mode = counters.mode();
+    cout
+    << "Counters: "
+    << (mode == cea::PerfMode::hardware? "hardware" :
+        mode == cea::PerfMode::software? "software" : "off")
+    << (counters.usesRdpmc()? ", read with rdpmc" :
+        mode == cea::PerfMode::off? "" : ", read with read()")
+    << "\n\nAverage cost per operation\n\n";
+
+    measure("PerfCounters::read()", 1'000'000, [&counters] {
+        sink = counters.read().values[0];
+    });
+
+    cea::Timer timer;
+    measure("Timer start() + stop()", 1'000'000, [&timer] {
+        timer.start();
+        timer.stop();
+    });
+
+    cea::PerfTimer perf_timer;
+    measure("PerfTimer start() + stop()", 1'000'000, [&perf_timer] {
+        perf_timer.start();
+        perf_timer.stop();
+    });
+    return 0;
+}
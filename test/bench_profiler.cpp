@@ -0,0 +1,119 @@
+/******************************************************************************
+ * @file bench_profiler.cpp
+ * @brief Benchmark of the BasicProfiler regions.
+ *
+ * Measures the overhead of entering and leaving a region, for each available
+ * clock policy, in a flat loop, nested three levels deep, and alternating
+ * between siblings. A fake clock that only increments a counter isolates the
+ * cost of the bookkeeping from the cost of the clock reads.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/clocks.hpp"
+#include "timer/profiler.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+//-------------------------------[ Fake clock ]-------------------------------//
+
+// A clock that costs (almost) nothing to read.
+struct CounterClock {
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<CounterClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept {
+        return time_point {duration {++counter}};
+    }
+
+    static inline std::int64_t counter = 0;
+};
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Number of regions per measurement.
+static constexpr std::int64_t NUM_REGIONS = 10'000'000;
+
+// Runs `body` NUM_REGIONS / `regions_per_call` times and returns the cost
+// per region.
+template <class Body>
+double costPerRegion(int regions_per_call, Body&& body) {
+    const auto num_calls = NUM_REGIONS / regions_per_call;
+    const auto begin = steady_clock::now();
+    for(std::int64_t i = 0; i < num_calls; ++i)
+        body();
+    const auto end = steady_clock::now();
+    return static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+           / static_cast<double>(num_calls * regions_per_call);
+}
+
+template <class Clock>
+void benchmarkClock(const char* name) {
+    using Region = typename cea::BasicProfiler<Clock>::Region;
+
+    // Warm up: calibration and first allocation of the nodes.
+    { Region region {"flat"}; }
+
+    const double flat_cost = costPerRegion(1, [] {
+        Region region {"flat"};
+    });
+
+    const double nested_cost = costPerRegion(3, [] {
+        Region outer {"outer"};
+        Region middle {"middle"};
+        Region inner {"inner"};
+    });
+
+    // Alternating siblings miss the last-child shortcut, and hit the next
+    // sibling one.
+    const double siblings_cost = costPerRegion(2, [] {
+        { Region first {"first"}; }
+        { Region second {"second"}; }
+    });
+
+    const auto report = cea::BasicProfiler<Clock>::report();
+    if(report.find("flat")->calls < NUM_REGIONS)
+        cerr << "Missing calls" << endl;
+
+    cout
+    << left << setw(24) << name << right << fixed << setprecision(2)
+    << setw(10) << flat_cost
+    << setw(10) << nested_cost
+    << setw(12) << siblings_cost
+    << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout
+    << "Cost per region entry and exit in nanoseconds ("
+    << NUM_REGIONS << " regions)\n\n"
+    << left << setw(24) << "Clock" << right
+    << setw(10) << "flat"
+    << setw(10) << "nested"
+    << setw(12) << "siblings"
+    << endl;
+
+    benchmarkClock<CounterClock>("no clock (bookkeeping)");
+    benchmarkClock<steady_clock>("steady_clock");
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    benchmarkClock<cea::MonotonicCoarseClock>("MonotonicCoarseClock");
+    #endif
+    benchmarkClock<cea::TscClock>(
+        cea::TscClock::isInvariant()? "TscClock" : "TscClock (fallback)");
+    return 0;
+}
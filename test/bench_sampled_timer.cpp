@@ -0,0 +1,85 @@
+/******************************************************************************
+ * @file bench_sampled_timer.cpp
+ * @brief Benchmark of the BasicSampledTimer class.
+ *
+ * Compares the cost of timing a tiny region on every call, with a Timer on
+ * TscClock, against sampling it with a fixed and an adaptive period.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/benchmark.hpp"
+#include "timer/clocks.hpp"
+#include "timer/sampled_timer.hpp"
+#include "timer/timer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace std::chrono;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Runs `operation` `iterations` times and prints the average cost.
+template <class Operation>
+void measure(const std::string& name, std::int64_t iterations,
+             Operation operation) {
+    const auto begin = steady_clock::now();
+    for(std::int64_t i = 0; i < iterations; ++i)
+        operation();
+    const auto end = steady_clock::now();
+    cout << left << setw(36) << name << right << fixed << setprecision(2)
+         << setw(12)
+         << static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+            / static_cast<double>(iterations)
+         << " ns" << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    constexpr std::int64_t num_calls = 50'000'000;
+    std::uint64_t value = 1;
+
+    // The region: a few dependent multiplications.
+    const auto region = [&value] {
+        for(int j = 0; j < 4; ++j)
+            value = value * 6364136223846793005 + 1;
+        cea::doNotOptimize(value);
+    };
+
+    cout << "Average cost per call of a tiny region\n\n";
+
+    measure("no timing", num_calls, region);
+
+    cea::BasicTimer<cea::TscClock> timer;
+    measure("Timer<TscClock> on every call", num_calls, [&] {
+        timer.start();
+        region();
+        timer.stop();
+    });
+
+    cea::BasicSampledTimer<cea::TscClock, 1024> fixed_timer;
+    measure("SampledTimer, 1 in 1024", num_calls, [&] {
+        const auto sample = fixed_timer.measure();
+        region();
+    });
+
+    cea::SampledTimer adaptive_timer(0.01);
+    measure("SampledTimer, 1% budget", num_calls, [&] {
+        const auto sample = adaptive_timer.measure();
+        region();
+    });
+
+    cout << "\nAdaptive estimate (1 in " << adaptive_timer.period() << ")\n";
+    adaptive_timer.estimate().print(cout);
+    return 0;
+}
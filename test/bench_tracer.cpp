@@ -0,0 +1,95 @@
+/******************************************************************************
+ * @file bench_tracer.cpp
+ * @brief Benchmark of the Tracer class.
+ *
+ * Measures the cost of recording an event with tracing off and on, and the
+ * cost of a profiling region with tracing off and on. The trace goes to a
+ * stream that discards it, so only the recording is measured.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/profiler.hpp"
+#include "timer/tracer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <thread>
+
+using namespace std;
+using namespace std::chrono;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Runs `operation` `iterations` times and prints the average cost.
+template <class Operation>
+void measure(const std::string& name, std::int64_t iterations,
+             Operation operation) {
+    const auto begin = steady_clock::now();
+    for(std::int64_t i = 0; i < iterations; ++i)
+        operation();
+    const auto end = steady_clock::now();
+    cout << left << setw(36) << name << right << fixed << setprecision(2)
+         << setw(12)
+         << static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+            / static_cast<double>(iterations)
+         << " ns" << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    // Batches small enough for the flusher to keep up, so nothing is dropped.
+    constexpr std::int64_t iterations = 1'000;
+    constexpr int batches = 500;
+    std::ostream discard {nullptr};
+
+    cout << "Average cost per operation\n\n";
+
+    measure("instant(), tracing off", iterations * batches, [] {
+        cea::Tracer::instant("event", "bench");
+    });
+    measure("ProfileRegion, tracing off", iterations * batches, [] {
+        cea::ProfileRegion region {"region"};
+    });
+
+    cea::Tracer::start(discard, milliseconds {1});
+    double instant_cost = 0.0, region_cost = 0.0;
+    for(int batch = 0; batch < batches; ++batch) {
+        auto begin = steady_clock::now();
+        for(std::int64_t i = 0; i < iterations; ++i)
+            cea::Tracer::instant("event", "bench");
+        auto end = steady_clock::now();
+        instant_cost += static_cast<double>((end - begin).count());
+
+        begin = steady_clock::now();
+        for(std::int64_t i = 0; i < iterations / 2; ++i) {
+            cea::ProfileRegion region {"region"};
+        }
+        end = steady_clock::now();
+        region_cost += static_cast<double>((end - begin).count());
+
+        // Let the flusher drain the buffer.
+        std::this_thread::sleep_for(milliseconds {2});
+    }
+    const auto dropped = cea::Tracer::droppedEvents();
+    cea::Tracer::stop();
+
+    cout
+    << left << setw(36) << "instant(), tracing on" << right << fixed
+    << setprecision(2) << setw(12)
+    << instant_cost / static_cast<double>(iterations * batches) << " ns\n"
+    << left << setw(36) << "ProfileRegion, tracing on" << right
+    << setw(12)
+    << region_cost / static_cast<double>(iterations / 2 * batches) << " ns\n"
+    << "\nDropped events: " << dropped << endl;
+    return 0;
+}
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * @file bench_work_budget.cpp
+ * @brief Contention benchmark of the ExecutionStopper work accounting.
+ *
+ * From 1 to 128 threads, measures the cost of reporting a unit of work with
+ * `ExecutionStopper::consume()`, with and without a work budget, against a
+ * single counter shared by all threads.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/execution_stopper.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//----------------------------[ Benchmark driver ]----------------------------//
+
+// Duration of each measurement.
+static constexpr auto MEASUREMENT_TIME = 100ms;
+
+// Runs `work` in `num_threads` threads for MEASUREMENT_TIME. Returns the
+// average cost of a call in nanoseconds, per thread.
+template <class Work>
+double nsPerUnit(unsigned num_threads, Work work) {
+    std::atomic<bool> go {false}, done {false};
+    std::atomic<std::int64_t> num_units {0};
+
+    std::vector<std::thread> workers;
+    for(unsigned i = 0; i < num_threads; ++i) {
+        workers.emplace_back([&] {
+            while(!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            std::int64_t units = 0;
+            while(!done.load(std::memory_order_relaxed)) {
+                // Unrolled, so the loop control does not dominate.
+                for(int j = 0; j < 16; ++j)
+                    work();
+                units += 16;
+            }
+            num_units += units;
+        });
+    }
+
+    go.store(true, std::memory_order_release);
+    const auto begin = steady_clock::now();
+    std::this_thread::sleep_for(MEASUREMENT_TIME);
+    done.store(true);
+    const auto end = steady_clock::now();
+    for(auto& worker : workers)
+        worker.join();
+
+    return num_threads *
+           static_cast<double>(duration_cast<nanoseconds>(end - begin).count())
+           / static_cast<double>(num_units.load());
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    using exec = cea::ExecutionStopper;
+    std::atomic<std::int64_t> shared {0};
+
+    cout
+    << "Cost per unit of work in nanoseconds, per thread\n"
+    << "(" << std::thread::hardware_concurrency() << " hardware threads; "
+    << "beyond that, threads are oversubscribed)\n\n"
+    << right
+    << setw(8) << "Threads"
+    << setw(12) << "shared"
+    << setw(12) << "unlimited"
+    << setw(12) << "budgeted"
+    << endl;
+
+    for(unsigned num_threads = 1; num_threads <= 128; num_threads *= 2) {
+        const double shared_cost = nsPerUnit(num_threads, [&] {
+            shared.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        exec::setWorkBudget(0);
+        exec::start();
+        const double unlimited_cost = nsPerUnit(num_threads, [] {
+            exec::consume();
+        });
+
+        // Large enough not to run out during the measurement.
+        exec::setWorkBudget(std::int64_t {1} << 50);
+        exec::start();
+        const double budgeted_cost = nsPerUnit(num_threads, [] {
+            exec::consume();
+        });
+
+        cout
+        << setw(8) << num_threads << fixed << setprecision(2)
+        << setw(12) << shared_cost
+        << setw(12) << unlimited_cost
+        << setw(12) << budgeted_cost
+        << endl;
+    }
+    return 0;
+}
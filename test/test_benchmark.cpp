@@ -0,0 +1,231 @@
+/******************************************************************************
+ * @file test_benchmark.cpp
+ * @brief Testing code for the BenchmarkRunner class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/benchmark.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+// Keeps a core busy for the given wall time.
+void spin(nanoseconds duration) {
+    const auto end = steady_clock::now() + duration;
+    while(steady_clock::now() < end)
+        ;
+}
+
+// Returns true if `a` and `b` are equal, up to rounding.
+bool near(double a, double b) {
+    return std::abs(a - b) < 1e-9;
+}
+
+// Exposes the statistics and the results of the runner.
+class TestRunner: public cea::BenchmarkRunner {
+public:
+    using BenchmarkRunner::BenchmarkRunner;
+    using BenchmarkRunner::summarize;
+    using BenchmarkRunner::benchmark_results;
+};
+
+// One call per sample, and no warm-up beyond the first call, so the runs do
+// not depend on how fast the machine is or how it is scheduled.
+cea::BenchmarkOptions singleCallOptions() {
+    cea::BenchmarkOptions options;
+    options.warmup_time = 0ns;
+    options.sample_time = 1ns;
+    options.num_samples = 20;
+    return options;
+}
+
+// Returns a result with the given median and confidence interval.
+cea::BenchmarkResult makeResult(const std::string& name, double median,
+                                double ci_low, double ci_high) {
+    cea::BenchmarkResult result;
+    result.name = name;
+    result.iterations = 100;
+    result.samples = 30;
+    result.median = result.mean = median;
+    result.ci_low = result.min = ci_low;
+    result.ci_high = result.max = ci_high;
+    result.complete = true;
+    return result;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- Median and its interval of fixed samples: ";
+    {
+        TestRunner runner;
+        cea::BenchmarkResult result;
+        // 1 to 21, shuffled.
+        runner.summarize({14, 3, 21, 8, 1, 17, 11, 6, 19, 2, 12, 9, 16, 4,
+                          20, 7, 13, 5, 18, 10, 15}, result);
+        // With n = 21 and 95% confidence, the interval of the median goes
+        // from the 6th to the 15th order statistics.
+        const bool ok =
+            result.samples == 21 && result.outliers == 0 &&
+            near(result.median, 11.0) && near(result.mean, 11.0) &&
+            near(result.stddev, std::sqrt(770.0 / 20.0)) &&
+            near(result.ci_low, 6.0) && near(result.ci_high, 15.0) &&
+            near(result.min, 1.0) && near(result.max, 21.0);
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Outliers are rejected: ";
+    {
+        TestRunner runner;
+        cea::BenchmarkResult result;
+        runner.summarize({10, 11, 12, 10, 11, 12, 10, 11, 500, 11}, result);
+        const bool ok = result.outliers == 1 && result.samples == 9 &&
+                        result.max < 13 && result.median > 10.5 &&
+                        result.median < 11.5;
+
+        // Without fences, every sample is kept.
+        cea::BenchmarkOptions options;
+        options.outlier_fence = 0.0;
+        TestRunner keep_all(options);
+        cea::BenchmarkResult all;
+        keep_all.summarize({10, 11, 12, 10, 11, 12, 10, 11, 500, 11}, all);
+        const bool kept = all.outliers == 0 && all.samples == 10 &&
+                          near(all.max, 500.0);
+        cout << (ok && kept? "OK" : "FAILED") << endl;
+        assert(ok && kept);
+    }
+
+    cout << "- run() takes the samples and summarizes them: ";
+    {
+        cea::BenchmarkRunner runner(singleCallOptions());
+        std::uint64_t calls = 0;
+        const auto& result = runner.run("spin 1us", [&] {
+            ++calls;
+            spin(1us);
+        });
+        // The spin lasts at least 1us, whatever the load.
+        const bool ok =
+            result.complete && result.iterations == 1 && calls == 21 &&
+            result.samples + result.outliers == 20 &&
+            result.min >= 1'000.0 &&
+            result.min <= result.ci_low && result.ci_low <= result.median &&
+            result.median <= result.ci_high && result.ci_high <= result.max;
+        cout << (ok? "OK" : "FAILED") << endl;
+        runner.print(cout);
+        assert(ok);
+    }
+
+    cout << "- An expired scope stops the suite: ";
+    {
+        cea::StopScope scope;
+        scope.start();
+        auto options = singleCallOptions();
+        options.num_samples = 1000;
+        cea::BenchmarkRunner runner(options, scope);
+        std::int64_t calls = 0;
+        // The first call warms up; the next nine are samples.
+        const auto& stopped = runner.run("stopped", [&] {
+            spin(1us);
+            if(++calls == 10)
+                scope.expire();
+        });
+        const bool was_stopped = !stopped.complete &&
+                                 stopped.samples + stopped.outliers == 9;
+        const auto& skipped = runner.run("skipped", [] { spin(1us); });
+        const bool ok = was_stopped && calls == 10 && !skipped.complete &&
+                        skipped.samples == 0 && runner.results().size() == 2;
+        cout << (ok? "OK" : "FAILED") << endl;
+        runner.print(cout);
+        assert(ok);
+    }
+
+    cout << "- CSV round trip and baseline comparison: ";
+    {
+        TestRunner runner;
+        runner.benchmark_results = {
+            makeResult("spin \"5us\", busy", 5'000.0, 4'950.0, 5'050.0),
+            makeResult("spin 10us", 10'000.0, 9'900.0, 10'100.0),
+            makeResult("noisy", 1'000.0, 500.0, 2'000.0)
+        };
+
+        std::stringstream csv;
+        runner.writeCsv(csv);
+        std::vector<cea::BenchmarkResult> baseline;
+        bool ok = cea::BenchmarkRunner::readCsv(csv, baseline) &&
+                  baseline.size() == 3 &&
+                  baseline[0].name == "spin \"5us\", busy" &&
+                  baseline[0].iterations == 100 &&
+                  baseline[0].samples == 30 &&
+                  near(baseline[0].median, 5'000.0) &&
+                  near(baseline[1].ci_high, 10'100.0) &&
+                  baseline[1].complete;
+
+        std::ostringstream same;
+        ok = ok && runner.compare(baseline, same) == 0;
+
+        // A baseline twice as fast makes the current run a regression,
+        // unless the intervals still overlap.
+        for(auto& result : baseline) {
+            result.median /= 2;
+            result.ci_low /= 2;
+            result.ci_high /= 2;
+        }
+        std::ostringstream regressed;
+        ok = ok && runner.compare(baseline, regressed) == 2 &&
+             regressed.str().find("slower") != std::string::npos;
+
+        // And twice as slow, an improvement, which is not counted.
+        for(auto& result : baseline) {
+            result.median *= 4;
+            result.ci_low *= 4;
+            result.ci_high *= 4;
+        }
+        std::ostringstream improved;
+        ok = ok && runner.compare(baseline, improved) == 0 &&
+             improved.str().find("faster") != std::string::npos;
+
+        std::istringstream malformed("name,iterations\n\"x\",1,2\n");
+        ok = ok && !cea::BenchmarkRunner::readCsv(malformed, baseline) &&
+             baseline.size() == 3;
+
+        std::ostringstream json;
+        runner.writeJson(json);
+        ok = ok && json.str().find("\"spin \\\"5us\\\", busy\"") !=
+                   std::string::npos;
+        cout << (ok? "OK" : "FAILED") << endl;
+        cout << regressed.str();
+        assert(ok);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
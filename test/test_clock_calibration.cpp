@@ -0,0 +1,155 @@
+/******************************************************************************
+ * @file test_clock_calibration.cpp
+ * @brief Testing code for the ClockCalibration and BasicCalibratedTimer
+ *        classes.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/clock_calibration.hpp"
+#include "timer/clocks.hpp"
+#include "timer/virtual_clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+// Keeps a core busy for the given wall time.
+void spin(nanoseconds duration) {
+    const auto end = steady_clock::now() + duration;
+    while(steady_clock::now() < end)
+        ;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- Calibration of steady_clock: ";
+    {
+        const auto& calibration = cea::ClockCalibration::of<>();
+        const bool ok =
+            &calibration == &cea::ClockCalibration::of<steady_clock>() &&
+            calibration.resolution > 0ns && calibration.resolution < 1us &&
+            calibration.read_overhead > 0ns &&
+            calibration.read_overhead < 10us &&
+            calibration.timer_bias >= 0ns && calibration.timer_bias < 10us;
+        cout << (ok? "OK" : "FAILED") << endl;
+        calibration.print(cout);
+        assert(ok);
+    }
+
+    cout << "- Empty regions measure about zero: ";
+    {
+        const auto bias = cea::ClockCalibration::of<>().timer_bias;
+        std::vector<nanoseconds> raw, calibrated;
+        cea::CalibratedTimer timer;
+        for(int i = 0; i < 1001; ++i) {
+            timer.start();
+            timer.stop();
+            raw.push_back(timer.rawElapsedInNanoseconds());
+            calibrated.push_back(timer.elapsedInNanoseconds());
+        }
+        std::sort(raw.begin(), raw.end());
+        std::sort(calibrated.begin(), calibrated.end());
+        const auto raw_median = raw[raw.size() / 2];
+        const auto median = calibrated[calibrated.size() / 2];
+        const bool ok = median >= 0ns && median <= raw_median &&
+                        (bias == 0ns || median < raw_median) &&
+                        median <= bias / 2 + 5ns;
+        cout << (ok? "OK" : "FAILED") << " (" << median << ", raw "
+             << raw_median << ")" << endl;
+        assert(ok);
+    }
+
+    cout << "- The bias is subtracted once per region: ";
+    {
+        const auto bias = cea::ClockCalibration::of<>().timer_bias;
+        cea::CalibratedTimer timer;
+        timer.start();
+        spin(100us);
+        timer.stop();
+        timer.resume();
+        spin(100us);
+        timer.stop();
+        timer.resume();             // Resuming a running timer does nothing.
+        timer.resume();
+        spin(100us);
+        timer.stop();
+        const bool ok =
+            timer.rawElapsedInNanoseconds() - timer.elapsedInNanoseconds() ==
+                3 * bias &&
+            timer.elapsedInNanoseconds() >= 300us - 3 * bias &&
+            !timer.isBelowResolution();
+        cout << (ok? "OK" : "FAILED") << endl;
+        timer.print(cout);
+        assert(ok);
+    }
+
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    cout << "- Regions below a coarse clock resolution are flagged: ";
+    {
+        const auto& calibration =
+            cea::ClockCalibration::of<cea::MonotonicCoarseClock>();
+        cea::BasicCalibratedTimer<cea::MonotonicCoarseClock> timer;
+        timer.start();
+        timer.stop();
+        const bool ok =
+            calibration.resolution >=
+                cea::MonotonicCoarseClock::resolution() / 2 &&
+            timer.isBelowResolution();
+        cout << (ok? "OK" : "FAILED") << endl;
+        calibration.print(cout);
+        timer.print(cout);
+        assert(ok);
+    }
+    #endif
+
+    cout << "- A frozen clock has an unknown resolution: ";
+    {
+        cea::VirtualClock::enable();
+        const auto begin = steady_clock::now();
+        const auto calibration =
+            cea::ClockCalibration::measure<cea::VirtualClock>();
+        cea::BasicCalibratedTimer<cea::VirtualClock> timer;
+        const auto took = steady_clock::now() - begin;
+        cea::VirtualClock::disable();
+
+        std::ostringstream text;
+        calibration.print(text);
+        const bool ok = calibration.resolution == 0ns &&
+                        calibration.timer_bias == 0ns && took < 5s &&
+                        text.str().find("unknown") != std::string::npos &&
+                        !timer.isBelowResolution();
+        cout << (ok? "OK" : "FAILED") << endl;
+        cout << text.str();
+        assert(ok);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * @file test_clocks.cpp
+ * @brief Testing code for the BasicTimer clock policies.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/clocks.hpp"
+#include "timer/timer.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test driver ]-------------------------------//
+
+// Runs the start/stop/resume cycle on a timer using the given clock policy.
+// Bounds are loose because coarse clocks only advance once per kernel tick.
+template <class Clock>
+void testClock(const char* name) {
+    cout << "\n- Testing " << name << endl;
+
+    cea::BasicTimer<Clock> timer;
+    assert(timer.isStopped());
+    assert(timer.elapsedInNanoseconds() == 0ns);
+
+    timer.start();
+    assert(!timer.isStopped());
+    std::this_thread::sleep_for(100ms);
+    const auto running = timer.elapsedInNanoseconds();
+    cout << "  - Elapsed after 100ms: " << running << endl;
+    assert(running > 80ms);
+    assert(running < 500ms);
+
+    timer.stop();
+    const auto stopped = timer.elapsedInNanoseconds();
+    std::this_thread::sleep_for(50ms);
+    cout << "  - Stopped: " << (timer.isStopped()? "OK" : "FAILED") << endl;
+    assert(timer.isStopped());
+    assert(timer.elapsedInNanoseconds() == stopped);
+
+    timer.resume();
+    std::this_thread::sleep_for(100ms);
+    const auto resumed = timer.elapsedInNanoseconds();
+    cout << "  - Elapsed after resume + 100ms: " << resumed << endl;
+    assert(resumed > stopped + 80ms);
+    assert(resumed < stopped + 500ms);
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    static_assert(std::is_same_v<cea::Timer,
+                                 cea::BasicTimer<std::chrono::steady_clock>>);
+
+    testClock<std::chrono::steady_clock>("steady_clock");
+
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    cout
+    << "\n- Coarse clock resolution: "
+    << cea::MonotonicCoarseClock::resolution()
+    << endl;
+    assert(cea::MonotonicCoarseClock::resolution() > 0ns);
+
+    testClock<cea::MonotonicCoarseClock>("MonotonicCoarseClock");
+    testClock<cea::MonotonicRawClock>("MonotonicRawClock");
+    #endif
+
+    cout
+    << "\n- TSC invariant: " << (cea::TscClock::isInvariant()? "yes" : "no")
+    << ", frequency: " << cea::TscClock::ticksPerSecond() / 1e9 << " GHz"
+    << endl;
+    testClock<cea::TscClock>("TscClock");
+
+    // TscClock shares steady_clock's epoch, and must stay close to it. The
+    // bounds are loose since virtual machines make the calibration noisy.
+    cea::TscClock::checkDrift();
+    const auto tsc_now = cea::TscClock::now().time_since_epoch();
+    const auto steady_now = std::chrono::steady_clock::now().time_since_epoch();
+    cout
+    << "  - Drift after check: " << cea::TscClock::lastDrift()
+    << ", TscClock - steady_clock: " << (tsc_now - steady_now)
+    << endl;
+    assert(cea::TscClock::lastDrift() < 5ms);
+    assert(cea::TscClock::lastDrift() > -5ms);
+    assert(tsc_now - steady_now < 5ms);
+    assert(steady_now - tsc_now < 5ms);
+
+    // The clock must never go backwards, including across drift checks.
+    auto previous = cea::TscClock::now();
+    for(int i = 0; i < 1'000'000; ++i) {
+        if(i % 100'000 == 0)
+            cea::TscClock::checkDrift();
+        const auto current = cea::TscClock::now();
+        assert(current >= previous);
+        previous = current;
+    }
+    cout << "  - Monotonic: OK" << endl;
+
+    cout << "\nAll tests passed";
+    return 0;
+}
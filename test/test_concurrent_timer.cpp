@@ -0,0 +1,133 @@
+/******************************************************************************
+ * @file test_concurrent_timer.cpp
+ * @brief Testing code for the BasicConcurrentTimer class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/clocks.hpp"
+#include "timer/concurrent_timer.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test driver ]-------------------------------//
+
+// Runs the same start/stop/resume cycle as the BasicTimer tests.
+template <class Clock>
+void testSingleThread(const char* name) {
+    cout << "- Single thread, " << name << ": ";
+
+    cea::BasicConcurrentTimer<Clock> timer;
+    assert(timer.isStopped());
+    assert(timer.elapsedInNanoseconds() == 0ns);
+
+    timer.start();
+    assert(!timer.isStopped());
+    std::this_thread::sleep_for(100ms);
+    const auto running = timer.elapsedInNanoseconds();
+    assert(running > 80ms);
+    assert(running < 500ms);
+
+    timer.stop();
+    const auto stopped = timer.elapsedInNanoseconds();
+    std::this_thread::sleep_for(50ms);
+    assert(timer.isStopped());
+    assert(timer.elapsedInNanoseconds() == stopped);
+
+    timer.resume();
+    std::this_thread::sleep_for(100ms);
+    const auto resumed = timer.elapsedInNanoseconds();
+    assert(resumed > stopped + 80ms);
+    assert(resumed < stopped + 500ms);
+    cout << "OK" << endl;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    testSingleThread<std::chrono::steady_clock>("steady_clock");
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    testSingleThread<cea::MonotonicRawClock>("MonotonicRawClock");
+    #endif
+    testSingleThread<cea::TscClock>("TscClock");
+
+    // Readers hammer the timer while the controller toggles it as fast as it
+    // can. Each reader must see a consistent state: the elapsed time never
+    // goes backwards, and never exceeds the wall time since start().
+    const auto num_readers =
+        std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    cout
+    << "- " << num_readers << " readers while the controller toggles "
+    << "stop()/resume() for 500ms: ";
+    {
+        cea::ConcurrentTimer timer;
+        std::atomic<bool> done {false};
+        std::atomic<bool> consistent {true};
+        std::atomic<long> num_reads {0};
+
+        const auto begin = std::chrono::steady_clock::now();
+        timer.start();
+
+        std::vector<std::thread> readers;
+        for(unsigned i = 0; i < num_readers; ++i) {
+            readers.emplace_back([&] {
+                auto previous = 0ns;
+                long reads = 0;
+                while(!done.load(std::memory_order_relaxed)) {
+                    const auto elapsed = timer.elapsedInNanoseconds();
+                    const auto wall = std::chrono::steady_clock::now() - begin;
+                    if(elapsed < previous || elapsed > wall)
+                        consistent.store(false);
+                    previous = elapsed;
+                    ++reads;
+                }
+                num_reads += reads;
+            });
+        }
+
+        long num_toggles = 0;
+        while(std::chrono::steady_clock::now() - begin < 500ms) {
+            timer.stop();
+            timer.resume();
+            ++num_toggles;
+        }
+        done.store(true);
+        for(auto& reader : readers)
+            reader.join();
+
+        cout << (consistent? "OK" : "FAILED") << endl;
+        cout
+        << "  - " << num_toggles << " toggles, " << num_reads << " reads"
+        << endl;
+        assert(consistent);
+        assert(num_toggles > 0);
+        assert(num_reads > 0);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
@@ -6,15 +6,19 @@
  * SPDX-License-Identifier: BSD-3-Clause.
  *
  * Created on : 2015-06-17 by ceandrade.
- * Last update: 2026-07-26 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
  ******************************************************************************/
 
 #include "timer/execution_stopper.hpp"
+#include "timer/virtual_clock.hpp"
 
 #include <iostream>
+#include <atomic>
 #include <chrono>
 #include <csignal>
+#include <cstdint>
 #include <thread>
+#include <vector>
 
 using namespace std;
 using namespace std::chrono_literals;
@@ -35,6 +39,11 @@ using namespace std::chrono_literals;
 
 int main() {
     using exec = cea::ExecutionStopper;
+    using clock = cea::VirtualClock;
+
+    // The budgets run on virtual time, advanced by hand, so the test does
+    // not sleep. Signals and `waitFor()` still run on real time.
+    clock::enable();
 
     cout
     << "- After instantiation, the timer must not be expired: "
@@ -45,22 +54,22 @@ int main() {
     exec::setExpirationTime(5s);
     exec::start();
 
-    cout << "- Set expiration for 10 seconds. Sleep 2 seconds..." << endl;
-    std::this_thread::sleep_for(2s);
+    cout << "- Set expiration for 5 seconds. Advance 2 seconds..." << endl;
+    clock::advance(2s);
 
     cout << "- Elapsed time: " << exec::elapsed() << endl;
-    assert(exec::elapsed() < 2.1s);
+    assert(exec::elapsed() == 2s);
 
-    cout << "- Stop and sleep 2 seconds..." << endl;
+    cout << "- Stop and advance 2 seconds..." << endl;
     exec::stop();
-    std::this_thread::sleep_for(2s);
+    clock::advance(2s);
 
-    cout << "- Resume and sleep 2 seconds..." << endl;
+    cout << "- Resume and advance 2 seconds..." << endl;
     exec::resume();
-    std::this_thread::sleep_for(2s);
+    clock::advance(2s);
 
     cout << "- Elapsed time: " << exec::elapsed() << endl;
-    assert(exec::elapsed() < 4.1s);
+    assert(exec::elapsed() == 4s);
 
     cout
     << "- Should not be expired yet: "
@@ -68,8 +77,8 @@ int main() {
     << endl;
     assert(!exec::isExpired());
 
-    cout << "- Sleep 2 seconds for expiration..." << endl;
-    std::this_thread::sleep_for(2s);
+    cout << "- Advance 2 seconds for expiration..." << endl;
+    clock::advance(2s);
 
     cout
     << "- Should be expired by now: "
@@ -79,7 +88,7 @@ int main() {
     assert(exec::isExpired());
 
     cout << "- Elapsed time: " << exec::elapsed() << endl;
-    assert(exec::elapsed() < 6.1s);
+    assert(exec::elapsed() <= 6s);
 
     exec::start();
     cout
@@ -91,16 +100,176 @@ int main() {
     cout << "- Elapsed time: " << exec::elapsed() << endl;
     assert(exec::elapsed() == 0s);
 
+    cout << "- Set expiration for 1s, extend it to 3s, and advance 1.5s..."
+         << endl;
+    exec::setExpirationTime(1s);
+    exec::start();
+    exec::setExpirationTime(3s);
+    clock::advance(1500ms);
+    cout
+    << "- Should not be expired after the extension: "
+    << (!exec::isExpired()? "OK" : "FAILED")
+    << endl;
+    assert(!exec::isExpired());
+
+    exec::setExpirationTime(1s);
+    cout
+    << "- Bringing it back to 1s must expire right away: "
+    << (exec::isExpired()? "OK" : "FAILED")
+    << endl;
+    assert(exec::isExpired());
+
+    cout << "- Set expiration for 10s, bring it to 1s, and advance 1.2s..."
+         << endl;
+    exec::setExpirationTime(10s);
+    exec::start();
+    exec::setExpirationTime(1s);
+    clock::advance(1200ms);
+    cout
+    << "- The watchdog must honor the earlier deadline: "
+    << (exec::isExpired()? "OK" : "FAILED")
+    << endl;
+    assert(exec::isExpired());
+
+    cout << "- Without a work budget, work is only counted: ";
+    {
+        exec::setExpirationTime(10s);
+        exec::start();
+        for(int i = 0; i < 1000; ++i)
+            exec::consume();
+        exec::consume(500);
+        const bool ok = exec::workUsed() == 1500 && !exec::isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- The work budget expires exactly when used up: ";
+    {
+        exec::setWorkBudget(1000);
+        exec::start();
+        const bool restarted = exec::workUsed() == 0;
+        for(int i = 0; i < 999; ++i)
+            exec::consume();
+        const bool before = exec::isExpired();
+        exec::consume();
+        const bool ok = restarted && !before && exec::isExpired() &&
+                        exec::workUsed() == 1000;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Lowering the budget below the work done expires right away: ";
+    {
+        exec::setWorkBudget(1000);
+        exec::start();
+        exec::consume(600);
+        const bool before = exec::isExpired();
+        exec::setWorkBudget(500);
+        const bool ok = !before && exec::isExpired() &&
+                        exec::workUsed() == 600;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- The time budget still applies, whichever comes first: ";
+    {
+        exec::setWorkBudget(1'000'000);
+        exec::setExpirationTime(1s);
+        exec::start();
+        exec::consume(10);
+        clock::advance(1s);
+        const bool ok = exec::isExpired() && exec::workUsed() == 10;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Threads share the work budget: ";
+    {
+        constexpr std::int64_t budget = 1'000'000;
+        constexpr int num_threads = 4;
+        exec::setWorkBudget(budget);
+        exec::setExpirationTime(10s);
+        exec::start();
+        std::vector<std::jthread> workers;
+        for(int i = 0; i < num_threads; ++i)
+            workers.emplace_back([] {
+                while(!exec::isExpired())
+                    exec::consume();
+            });
+        workers.clear();
+        const auto used = exec::workUsed();
+        const bool ok =
+            exec::isExpired() &&
+            used >= budget - (num_threads - 1) * exec::max_work_chunk &&
+            used <= budget + num_threads;
+        cout << (ok? "OK" : "FAILED") << " (" << used << " used)" << endl;
+        assert(ok);
+        exec::setWorkBudget(0);
+    }
+
+    cout << "- Taking the quotas back loses no work: ";
+    {
+        constexpr std::int64_t units_per_thread = 200'000;
+        constexpr int num_threads = 4;
+        exec::setExpirationTime(10s);
+        exec::start();
+        std::atomic<int> running {num_threads};
+        std::vector<std::jthread> workers;
+        for(int i = 0; i < num_threads; ++i)
+            workers.emplace_back([&running] {
+                for(std::int64_t unit = 0; unit < units_per_thread; ++unit)
+                    exec::consume();
+                running.fetch_sub(1);
+            });
+        // Each change of budget takes back the quotas of the threads.
+        for(std::int64_t round = 0; running.load() > 0; ++round)
+            exec::setWorkBudget(round % 2 == 0? 0 : std::int64_t {1} << 40);
+        workers.clear();
+        const auto used = exec::workUsed();
+        const bool ok = !exec::isExpired() &&
+                        used == num_threads * units_per_thread;
+        cout << (ok? "OK" : "FAILED") << " (" << used << " used)" << endl;
+        assert(ok);
+        exec::setWorkBudget(0);
+    }
+
     exec::setExpirationTime(5s);
     exec::start();
-    std::this_thread::sleep_for(2s);
+    clock::advance(2s);
     std::raise(SIGINT);
 
+    // The signal thread expires the stopper right after the handler returns.
     cout
-    << "- After resetting, we wait 2 seconds and sent a Ctrl-C signal: "
-    << (exec::isExpired()? "OK" : "FAILED")
+    << "- After resetting, we advance 2 seconds and sent a Ctrl-C signal: "
+    << (exec::waitFor(1s)? "OK" : "FAILED")
     << endl;
     assert(exec::isExpired());
+    assert(exec::lastSignal() == SIGINT);
+
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    cout << "- SIGTERM and SIGUSR1 expire the stopper once handled: ";
+    {
+        bool ok = true;
+        for(const int signum : {SIGTERM, SIGUSR1}) {
+            exec::setExpirationTime(10s);
+            exec::start();
+            ok = ok && exec::handleSignal(signum) && !exec::isExpired();
+            std::raise(signum);
+            ok = ok && exec::waitFor(1s) && exec::lastSignal() == signum;
+        }
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+
+        // A released signal goes back to its previous handler.
+        exec::handleSignal(SIGUSR1);
+        exec::releaseSignal(SIGUSR1);
+        std::signal(SIGUSR1, SIG_IGN);
+        exec::setExpirationTime(10s);
+        exec::start();
+        std::raise(SIGUSR1);
+        assert(!exec::waitFor(100ms));
+    }
+    #endif
 
     cout << "All tests passed";
     return 0;
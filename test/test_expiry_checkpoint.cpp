@@ -0,0 +1,164 @@
+/******************************************************************************
+ * @file test_expiry_checkpoint.cpp
+ * @brief Testing code for the BasicExpiryCheckpoint class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/expiry_checkpoint.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//-----------------------------[ Manual clock ]-------------------------------//
+
+// A clock that only moves when told, to drive the adaptation.
+struct ManualClock {
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept { return time_point {current}; }
+
+    static inline duration current {0};
+};
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- A fixed checkpoint consults the scope every interval: ";
+    {
+        cea::StopScope scope;
+        scope.start();
+        cea::BasicExpiryCheckpoint<cea::TscClock, 8> checkpoint(scope);
+        bool ok = checkpoint.interval() == 8;
+        for(int i = 0; i < 100; ++i)
+            ok = ok && !checkpoint.isExpired();
+
+        // 100 calls leave 4 to the next check.
+        scope.expire();
+        for(int i = 0; i < 3; ++i)
+            ok = ok && !checkpoint.isExpired();
+        ok = ok && checkpoint.isExpired();
+
+        // Once expired, every call says so.
+        ok = ok && checkpoint.isExpired() && checkpoint.isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- forEach() runs the whole range while not expired: ";
+    {
+        cea::StopScope scope;
+        scope.start();
+        cea::BasicExpiryCheckpoint<cea::TscClock, 64> checkpoint(scope);
+        std::int64_t sum = 0;
+        const auto done = checkpoint.forEach(0, 1000,
+            [&sum](int i) { sum += i; });
+        const bool ok = done == 1000 && sum == 999 * 1000 / 2;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- forEach() stops at the block where it expired: ";
+    {
+        cea::StopScope scope;
+        scope.start();
+        cea::BasicExpiryCheckpoint<cea::TscClock, 64> checkpoint(scope);
+        int calls = 0;
+        const auto done = checkpoint.forEach(std::size_t {0},
+            std::size_t {1000}, [&](std::size_t i) {
+                ++calls;
+                if(i == 100)
+                    scope.expire();
+            });
+        const bool ok = done == 128 && calls == 128 &&
+                        checkpoint.forEach(done, std::size_t {1000},
+                                           [](std::size_t) {}) == 129;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- The countdown carries over between ranges: ";
+    {
+        cea::StopScope scope;
+        scope.start();
+        cea::BasicExpiryCheckpoint<cea::TscClock, 16> checkpoint(scope);
+        for(int range = 0; range < 3; ++range)
+            checkpoint.forEach(0, 5, [](int) {});
+        scope.expire();
+        int calls = 0;
+        const auto done = checkpoint.forEach(0, 10,
+            [&calls](int) { ++calls; });
+        const bool ok = done == 1 && calls == 1;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- The adaptive interval converges to the target latency: ";
+    {
+        cea::StopScope scope;
+        scope.start();
+        cea::BasicExpiryCheckpoint<ManualClock> checkpoint(scope, 1ms);
+        bool ok = checkpoint.interval() == 1 &&
+                  checkpoint.targetLatency() == 1ms;
+
+        // 1 us per iteration: between 250 and 500 iterations per check.
+        checkpoint.forEach(0, 100'000,
+            [](int) { ManualClock::current += 1us; });
+        const auto fast = checkpoint.interval();
+        ok = ok && fast >= 250 && fast <= 500;
+
+        // 10 times slower: it shrinks on the next check.
+        checkpoint.forEach(0, 2000,
+            [](int) { ManualClock::current += 10us; });
+        const auto slow = checkpoint.interval();
+        ok = ok && slow >= 25 && slow <= 50;
+        cout << (ok? "OK" : "FAILED")
+             << " (" << fast << " and " << slow << " iterations)" << endl;
+        assert(ok);
+    }
+
+    cout << "- The default checkpoint is on the ExecutionStopper: ";
+    {
+        cea::ExecutionStopper::setExpirationTime(10s);
+        cea::ExecutionStopper::start();
+        cea::ExpiryCheckpoint checkpoint;
+        bool ok = checkpoint.targetLatency() == 1ms;
+        for(int i = 0; i < 1000; ++i)
+            ok = ok && !checkpoint.isExpired();
+        cea::ExecutionStopper::root().expire();
+        int calls = 0;
+        while(!checkpoint.isExpired())
+            ++calls;
+        ok = ok && calls < static_cast<int>(checkpoint.interval());
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
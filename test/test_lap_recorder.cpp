@@ -0,0 +1,217 @@
+/******************************************************************************
+ * @file test_lap_recorder.cpp
+ * @brief Testing code for the BasicLapRecorder class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/lap_recorder.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//--------------------------[ Allocation counting ]---------------------------//
+
+// Counts the allocations of the program, to check that laps do not allocate.
+static std::size_t num_allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++num_allocations;
+    if(void* pointer = std::malloc(size == 0? 1 : size))
+        return pointer;
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+//------------------------------[ Test helpers ]------------------------------//
+
+// Keeps a core busy for the given wall time.
+void spin(nanoseconds duration) {
+    const auto end = steady_clock::now() + duration;
+    while(steady_clock::now() < end)
+        ;
+}
+
+// Records `count` splits, and returns them.
+std::vector<std::int64_t> recordSplits(cea::LapRecorder& laps, int count) {
+    std::vector<std::int64_t> splits;
+    splits.reserve(static_cast<std::size_t>(count));
+    laps.start();
+    for(int i = 0; i < count; ++i)
+        splits.push_back(laps.split().count());
+    return splits;
+}
+
+// Returns the timestamps kept by `laps`.
+std::vector<std::int64_t> kept(const cea::LapRecorder& laps) {
+    std::vector<std::int64_t> timestamps;
+    laps.copyTimestamps(std::back_inserter(timestamps));
+    return timestamps;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- Laps and splits agree: ";
+    {
+        cea::LapRecorder laps(16);
+        laps.start();
+        nanoseconds total {0};
+        for(int i = 0; i < 5; ++i) {
+            spin(10us);
+            total += laps.lap();
+        }
+        spin(10us);
+        const auto split = laps.split();
+        const auto timestamps = kept(laps);
+        const bool ok = laps.numLaps() == 6 && laps.size() == 6 &&
+                        total >= 50us && split > total &&
+                        timestamps.size() == 6 &&
+                        timestamps[4] == total.count() &&
+                        timestamps[5] == split.count();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Drop keeps the first laps: ";
+    {
+        cea::LapRecorder laps(4, cea::LapOverflow::drop);
+        const auto splits = recordSplits(laps, 10);
+        const bool ok = laps.numLaps() == 10 && laps.size() == 4 &&
+                        kept(laps) == std::vector<std::int64_t>(
+                            splits.begin(), splits.begin() + 4) &&
+                        laps.lapIndex(0) == 0 && laps.lapIndex(3) == 3;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Ring keeps the last laps: ";
+    {
+        cea::LapRecorder laps(4, cea::LapOverflow::ring);
+        const auto splits = recordSplits(laps, 10);
+        std::vector<std::int64_t> deltas;
+        laps.copyDeltas(std::back_inserter(deltas));
+        const bool ok = laps.size() == 4 &&
+                        kept(laps) == std::vector<std::int64_t>(
+                            splits.end() - 4, splits.end()) &&
+                        laps.lapIndex(0) == 6 &&
+                        deltas.size() == 3 &&
+                        deltas[0] == splits[7] - splits[6] &&
+                        laps.summary().intervals == 3;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Sampled keeps laps spread over the run: ";
+    {
+        cea::LapRecorder laps(8, cea::LapOverflow::sampled);
+        const auto splits = recordSplits(laps, 100);
+        const auto timestamps = kept(laps);
+        bool ok = laps.stride() == 16 && laps.size() == 6 &&
+                  timestamps.size() == 6;
+        for(std::size_t i = 0; ok && i < timestamps.size(); ++i)
+            ok = timestamps[i] == splits[laps.lapIndex(i)];
+        ok = ok && laps.lapIndex(5) == 95;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Summary of the intervals: ";
+    {
+        cea::LapRecorder laps(64, cea::LapOverflow::sampled);
+        laps.start();
+        for(int i = 0; i < 200; ++i) {
+            spin(i == 100? 200us : 20us);
+            laps.lap();
+        }
+        const auto summary = laps.summary();
+        std::vector<std::int64_t> deltas;
+        laps.copyDeltas(std::back_inserter(deltas));
+        const auto stride = static_cast<std::int64_t>(laps.stride());
+        std::int64_t max = 0;
+        for(const auto delta : deltas)
+            max = std::max(max, delta / stride);
+        const bool ok = summary.intervals == laps.size() &&
+                        summary.intervals == deltas.size() &&
+                        summary.laps_per_interval == laps.stride() &&
+                        summary.min >= 20us && summary.mean >= 20us &&
+                        summary.mean < summary.max &&
+                        summary.max.count() == max;
+        cout << (ok? "OK" : "FAILED") << " (mean " << summary.mean
+             << ", max " << summary.max << " per lap)" << endl;
+        assert(ok);
+    }
+
+    cout << "- Recording never allocates: ";
+    {
+        bool ok = true;
+        for(const auto overflow : {cea::LapOverflow::ring,
+                                   cea::LapOverflow::drop,
+                                   cea::LapOverflow::sampled}) {
+            cea::LapRecorder laps(1000, overflow);
+            const auto before = num_allocations;
+            laps.start();
+            for(int i = 0; i < 100'000; ++i) {
+                laps.lap();
+                laps.split();
+            }
+            (void) laps.summary();
+            ok = ok && num_allocations == before;
+        }
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- CSV export: ";
+    {
+        cea::LapRecorder laps(4, cea::LapOverflow::ring);
+        const auto splits = recordSplits(laps, 6);
+        std::ostringstream csv;
+        laps.writeCsv(csv);
+        const auto expected =
+            "lap,time_ns,delta_ns\n" +
+            std::to_string(2) + ',' + std::to_string(splits[2]) + ",\n" +
+            std::to_string(3) + ',' + std::to_string(splits[3]) + ',' +
+            std::to_string(splits[3] - splits[2]) + '\n';
+        const bool ok = csv.str().rfind(expected, 0) == 0;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
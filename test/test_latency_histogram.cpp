@@ -0,0 +1,192 @@
+/******************************************************************************
+ * @file test_latency_histogram.cpp
+ * @brief Testing code for the LatencyHistogram class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/latency_histogram.hpp"
+#include "timer/timer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+// True if `value` is within the histogram resolution (1/128) of `expected`.
+bool closeTo(nanoseconds value, std::int64_t expected) {
+    const auto error = value.count() - expected;
+    return (error < 0? -error : error) <= expected / 128 + 1;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- Bucket layout is contiguous and covers the range: ";
+    {
+        using H = cea::LatencyHistogram;
+        bool ok = true;
+        for(std::size_t bucket = 0; bucket + 1 < H::num_buckets; ++bucket) {
+            ok = ok && H::highestOf(bucket) + 1 == H::lowestOf(bucket + 1) &&
+                 H::bucketOf(H::lowestOf(bucket)) == bucket &&
+                 H::bucketOf(H::highestOf(bucket)) == bucket;
+        }
+        ok = ok && H::bucketOf(H::max_value) == H::num_buckets - 1 &&
+             H::bucketOf(~std::uint64_t {0}) == H::num_buckets - 1 &&
+             H::highestOf(H::num_buckets - 1) == H::max_value;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Small values are exact, large ones within 1/128: ";
+    {
+        auto histogram = std::make_unique<cea::LatencyHistogram>();
+        for(std::int64_t value = 0; value < 128; ++value)
+            histogram->record(nanoseconds {value});
+        bool ok = histogram->count() == 128;
+        for(std::int64_t value = 0; value < 128; ++value)
+            ok = ok && histogram->countAt(nanoseconds {value}) == 1;
+
+        histogram->clear();
+        for(std::int64_t value = 1; value <= 1'000'000; ++value)
+            histogram->record(nanoseconds {value});
+        ok = ok &&
+             histogram->count() == 1'000'000 &&
+             histogram->min() == 1ns &&
+             histogram->max() == 1'000'000ns &&
+             histogram->mean() == 500'000ns &&
+             closeTo(histogram->valueAtPercentile(50.0), 500'000) &&
+             closeTo(histogram->valueAtPercentile(99.0), 990'000) &&
+             closeTo(histogram->valueAtPercentile(99.9), 999'000) &&
+             histogram->valueAtPercentile(100.0) == 1'000'000ns &&
+             histogram->valueAtPercentile(0.0) == 1ns;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Empty histogram and out-of-range values: ";
+    {
+        auto histogram = std::make_unique<cea::LatencyHistogram>();
+        bool ok = histogram->count() == 0 &&
+                  histogram->min() == 0ns &&
+                  histogram->max() == 0ns &&
+                  histogram->valueAtPercentile(99.0) == 0ns;
+        histogram->record(-5ns);
+        histogram->record(hours {10});
+        ok = ok && histogram->countAt(0ns) == 1 &&
+             histogram->countAt(hours {10}) == 1 &&
+             histogram->max() == hours {10};
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Fed by a timer: ";
+    {
+        auto histogram = std::make_unique<cea::LatencyHistogram>();
+        cea::Timer timer;
+        for(int i = 0; i < 5; ++i) {
+            timer.start();
+            std::this_thread::sleep_for(2ms);
+            histogram->recordElapsed(timer);
+        }
+        const bool ok = histogram->count() == 5 && histogram->min() >= 2ms;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Per-thread recording and lossless merge: ";
+    {
+        constexpr int num_threads = 4;
+        constexpr std::int64_t num_samples = 100'000;
+        std::vector<std::unique_ptr<cea::LatencyHistogram>> per_thread;
+        for(int i = 0; i < num_threads; ++i)
+            per_thread.push_back(std::make_unique<cea::LatencyHistogram>());
+
+        auto merged = std::make_unique<cea::LatencyHistogram>();
+        std::vector<std::thread> threads;
+        for(int i = 0; i < num_threads; ++i) {
+            threads.emplace_back([&histogram = *per_thread[i], i] {
+                for(std::int64_t j = 0; j < num_samples; ++j)
+                    histogram.record(nanoseconds {j * num_threads + i});
+            });
+        }
+        // Reading while the threads record is allowed.
+        while(per_thread[0]->count() < num_samples)
+            (void) per_thread[0]->valueAtPercentile(50.0);
+        for(auto& thread : threads)
+            thread.join();
+        for(auto& histogram : per_thread)
+            merged->merge(*histogram);
+
+        // The same samples recorded by a single histogram.
+        auto single = std::make_unique<cea::LatencyHistogram>();
+        for(std::int64_t j = 0; j < num_samples * num_threads; ++j)
+            single->record(nanoseconds {j});
+
+        bool ok = merged->count() == single->count() &&
+                  merged->min() == single->min() &&
+                  merged->max() == single->max() &&
+                  merged->mean() == single->mean();
+        for(double percentile : {0.0, 25.0, 50.0, 90.0, 99.0, 99.99, 100.0})
+            ok = ok && merged->valueAtPercentile(percentile) ==
+                       single->valueAtPercentile(percentile);
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Serialization round trip: ";
+    {
+        auto histogram = std::make_unique<cea::LatencyHistogram>();
+        for(std::int64_t value = 1; value <= 100'000; value += 7)
+            histogram->record(microseconds {value});
+
+        std::stringstream stream;
+        histogram->serialize(stream);
+        auto loaded = std::make_unique<cea::LatencyHistogram>();
+        bool ok = loaded->deserialize(stream) &&
+                  loaded->count() == histogram->count() &&
+                  loaded->min() == histogram->min() &&
+                  loaded->max() == histogram->max() &&
+                  loaded->mean() == histogram->mean();
+        for(double percentile : {50.0, 90.0, 99.0, 99.9})
+            ok = ok && loaded->valueAtPercentile(percentile) ==
+                       histogram->valueAtPercentile(percentile);
+
+        std::stringstream garbage {"not a histogram"};
+        ok = ok && !loaded->deserialize(garbage) && loaded->count() == 0;
+
+        std::stringstream truncated {stream.str().substr(0, 80)};
+        ok = ok && !loaded->deserialize(truncated) && loaded->count() == 0;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+        histogram->printSummary(cout);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
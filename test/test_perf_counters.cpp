@@ -0,0 +1,120 @@
+/******************************************************************************
+ * @file test_perf_counters.cpp
+ * @brief Testing code for the PerfCounters and PerfTimer classes.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/perf_counters.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+// Keeps the compiler from discarding the work.
+static volatile std::uint64_t sink = 0;
+
+// Some work: sums a vector many times.
+void work(std::size_t operations) {
+    std::vector<std::uint64_t> data(4096, 1);
+    std::uint64_t total = 0;
+    for(std::size_t i = 0; i < operations; ++i)
+        for(const auto value : data)
+            total += value;
+    sink = total;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    const auto mode = cea::PerfCounters::forThread().mode();
+    cout
+    << "- Counters opened in mode: "
+    << (mode == cea::PerfMode::hardware? "hardware" :
+        mode == cea::PerfMode::software? "software" : "off")
+    << (cea::PerfCounters::forThread().usesRdpmc()? " (rdpmc)" : "")
+    << endl;
+
+    cout << "- Counts only grow: ";
+    {
+        const auto before = cea::PerfCounters::forThread().read();
+        work(1000);
+        const auto after = cea::PerfCounters::forThread().read();
+        bool ok = before.mode == mode && after.mode == mode;
+        for(std::size_t i = 0; i < cea::PerfCounts::num_events; ++i)
+            ok = ok && after.values[i] >= before.values[i];
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Timer attributes counts to its running time only: ";
+    {
+        cea::PerfTimer timer;
+        timer.start();
+        work(2000);
+        timer.stop();
+        const auto stopped = timer.counts();
+        work(2000);
+        bool ok = timer.isStopped() && timer.counts().values == stopped.values;
+
+        timer.resume();
+        std::this_thread::sleep_for(20ms);
+        timer.stop();
+        const auto counts = timer.counts();
+
+        switch(mode) {
+        case cea::PerfMode::hardware:
+            ok = ok && stopped.instructions() > 2000 * 4096 &&
+                 stopped.cycles() > 0 && stopped.ipc() > 0.0;
+            break;
+        case cea::PerfMode::software:
+            ok = ok && stopped.taskClock() > 0ns &&
+                 stopped.taskClock() <= timer.elapsedInNanoseconds() &&
+                 counts.contextSwitches() > stopped.contextSwitches();
+            break;
+        case cea::PerfMode::off:
+            ok = ok && counts.values == cea::PerfCounts {}.values;
+            break;
+        }
+        cout << (ok? "OK" : "FAILED") << endl;
+        timer.print(cout, 2000);
+        assert(ok);
+    }
+
+    cout << "- Each thread counts on its own: ";
+    {
+        std::thread other {[mode] {
+            const auto& counters = cea::PerfCounters::forThread();
+            cout << ((counters.mode() == mode)? "OK" : "FAILED") << endl;
+            assert(counters.mode() == mode);
+        }};
+        other.join();
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
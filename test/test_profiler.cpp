@@ -0,0 +1,165 @@
+/******************************************************************************
+ * @file test_profiler.cpp
+ * @brief Testing code for the BasicProfiler class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/profiler.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+void presolve() {
+    cea::ProfileRegion region {"presolve"};
+    std::this_thread::sleep_for(20ms);
+}
+
+void iteration() {
+    cea::ProfileRegion region {"iteration"};
+    std::this_thread::sleep_for(5ms);
+}
+
+void solve() {
+    cea::ProfileRegion region {"solve"};
+    presolve();
+    for(int i = 0; i < 4; ++i)
+        iteration();
+    std::this_thread::sleep_for(10ms);
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- Nested regions in a single thread: ";
+    solve();
+    {
+        const auto report = cea::Profiler::report();
+        const auto* solve_entry = report.find("solve");
+        assert(solve_entry != nullptr);
+        const auto* presolve_entry = solve_entry->find("presolve");
+        const auto* iteration_entry = solve_entry->find("iteration");
+        assert(presolve_entry != nullptr);
+        assert(iteration_entry != nullptr);
+        assert(report.find("presolve") == nullptr);
+
+        const bool ok =
+            solve_entry->calls == 1 &&
+            presolve_entry->calls == 1 &&
+            iteration_entry->calls == 4 &&
+            solve_entry->inclusive >= 50ms &&
+            presolve_entry->inclusive >= 20ms &&
+            iteration_entry->inclusive >= 20ms &&
+            solve_entry->exclusive >= 10ms &&
+            solve_entry->exclusive < solve_entry->inclusive -
+                presolve_entry->inclusive;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+
+        // Exclusive plus sub-regions adds up to inclusive.
+        assert(solve_entry->exclusive + presolve_entry->inclusive +
+               iteration_entry->inclusive == solve_entry->inclusive);
+        report.print(cout);
+    }
+
+    cout << "- Trees of several threads, finished or not, are merged: ";
+    {
+        cea::Profiler::reset();
+        assert(cea::Profiler::report().find("solve")->calls == 0);
+
+        constexpr int num_threads = 4;
+        constexpr int num_calls = 1000;
+        std::vector<std::thread> threads;
+        for(int i = 0; i < num_threads; ++i) {
+            threads.emplace_back([] {
+                for(int j = 0; j < num_calls; ++j) {
+                    cea::ProfileRegion outer {"worker"};
+                    cea::ProfileRegion inner {"step"};
+                }
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        // Records of the main thread as well.
+        for(int j = 0; j < num_calls; ++j) {
+            cea::ProfileRegion outer {"worker"};
+            cea::ProfileRegion inner {"step"};
+        }
+
+        const auto report = cea::Profiler::report();
+        const auto* worker = report.find("worker");
+        assert(worker != nullptr);
+        const auto* step = worker->find("step");
+        assert(step != nullptr);
+        const bool ok = worker->calls == (num_threads + 1) * num_calls &&
+                        step->calls == worker->calls &&
+                        step->inclusive <= worker->inclusive;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Same region name from different call sites: ";
+    {
+        cea::Profiler::reset();
+        // Distinct arrays, so the pointers differ.
+        static const char first[] = "dynamic";
+        static const char second[] = "dynamic";
+        for(int i = 0; i < 10; ++i) {
+            cea::ProfileRegion region {(i % 2 == 0)? first : second};
+        }
+        const auto report = cea::Profiler::report();
+        const auto* entry = report.find("dynamic");
+        cout << ((entry != nullptr && entry->calls == 10)? "OK" : "FAILED")
+             << endl;
+        assert(entry != nullptr);
+        assert(entry->calls == 10);
+    }
+
+    cout << "- Siblings in cycles and out of order: ";
+    {
+        cea::Profiler::reset();
+        static const char* const names[] {"a", "b", "c"};
+        for(int i = 0; i < 30; ++i) {
+            { cea::ProfileRegion region {names[i % 3]}; }
+            // Break the cycle now and then.
+            if(i % 7 == 0) {
+                cea::ProfileRegion region {names[(i + 2) % 3]};
+            }
+        }
+        const auto report = cea::Profiler::report();
+        const auto* a = report.find("a");
+        const auto* b = report.find("b");
+        const auto* c = report.find("c");
+        const bool ok = a != nullptr && b != nullptr && c != nullptr &&
+                        a->calls == 12 && b->calls == 11 && c->calls == 12;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * @file test_resource_usage.cpp
+ * @brief Testing code for the CPU-time clocks, UsageMeter, and the CPU-time
+ *        budget of the ExecutionStopper.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/execution_stopper.hpp"
+#include "timer/resource_usage.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+// Keeps a core busy for the given wall time.
+void spin(nanoseconds duration) {
+    const auto end = steady_clock::now() + duration;
+    while(steady_clock::now() < end)
+        ;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    cout << "- Thread CPU timer ignores sleeping, counts computing: ";
+    {
+        cea::ThreadCpuTimer timer;
+        timer.start();
+        std::this_thread::sleep_for(100ms);
+        const auto asleep = timer.elapsedInNanoseconds();
+
+        // Compute until the thread got 50 ms of CPU, however long the
+        // scheduler takes to give them; it cannot take less wall time.
+        const auto begin = steady_clock::now();
+        while(timer.elapsedInNanoseconds() - asleep < 50ms &&
+              steady_clock::now() - begin < 10s)
+            ;
+        const auto wall = steady_clock::now() - begin;
+        const auto busy = timer.elapsedInNanoseconds() - asleep;
+        const bool ok = busy >= 50ms && busy <= wall + 1ms &&
+                        asleep < busy / 2;
+        cout << (ok? "OK" : "FAILED") << " (" << asleep << " asleep, "
+             << busy << " busy)" << endl;
+        assert(ok);
+    }
+
+    cout << "- Usage meter tells computing from blocking: ";
+    {
+        cea::UsageMeter meter;
+        meter.start();
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 2; ++i)
+            threads.emplace_back([] { spin(200ms); });
+        for(auto& thread : threads)
+            thread.join();
+        const auto busy = meter.report();
+
+        meter.start();
+        std::this_thread::sleep_for(200ms);
+        const auto idle = meter.report();
+
+        const bool ok =
+            busy.wall >= 200ms &&
+            busy.cpuUtilization() > 0.5 &&
+            busy.usage.user + busy.usage.system > 100ms &&
+            busy.parallelEfficiency(2) < busy.cpuUtilization() &&
+            idle.wall >= 200ms &&
+            idle.cpuUtilization() < 0.2 &&
+            idle.usage.voluntary_switches >= 1;
+        cout << (ok? "OK" : "FAILED") << endl;
+        busy.print(cout, 2);
+        idle.print(cout, 1);
+        assert(ok);
+    }
+
+    cout << "- CPU-time budget expires the stopper: ";
+    {
+        cea::ExecutionStopper::setExpirationTime(10s);
+        assert(cea::ExecutionStopper::setCpuTimeBudget(200ms));
+        cea::ExecutionStopper::start();
+
+        // Sleeping does not use the budget.
+        std::this_thread::sleep_for(300ms);
+        bool ok = !cea::ExecutionStopper::isExpired();
+
+        // Nor does computing while stopped.
+        cea::ExecutionStopper::stop();
+        const auto used = cea::ExecutionStopper::cpuTimeUsed();
+        spin(100ms);
+        ok = ok && cea::ExecutionStopper::cpuTimeUsed() == used &&
+             !cea::ExecutionStopper::isExpired();
+        cea::ExecutionStopper::resume();
+
+        const auto begin = steady_clock::now();
+        while(!cea::ExecutionStopper::isExpired() &&
+              steady_clock::now() - begin < 5s)
+            ;
+        const auto consumed = cea::ExecutionStopper::cpuTimeUsed();
+        ok = ok && cea::ExecutionStopper::isExpired() &&
+             consumed >= 200ms && consumed < 300ms &&
+             cea::ExecutionStopper::elapsedInNanoseconds() < 5s;
+        cout << (ok? "OK" : "FAILED") << " (" << consumed << " used)"
+             << endl;
+        assert(ok);
+        cea::ExecutionStopper::setCpuTimeBudget(0ns);
+    }
+    #endif
+
+    cout << "All tests passed";
+    return 0;
+}
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * @file test_sampled_timer.cpp
+ * @brief Testing code for the BasicSampledTimer class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/benchmark.hpp"
+#include "timer/sampled_timer.hpp"
+#include "timer/timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+// Keeps a core busy for the given wall time.
+void spin(nanoseconds duration) {
+    const auto end = steady_clock::now() + duration;
+    while(steady_clock::now() < end)
+        ;
+}
+
+// Return the relative difference between `a` and `b`.
+double relativeError(nanoseconds a, nanoseconds b) {
+    return std::abs(static_cast<double>((a - b).count())) /
+           static_cast<double>(b.count());
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- Fixed period estimates the total time: ";
+    {
+        // Known durations, so the check does not depend on the scheduler;
+        // only on the random sampling, within six standard errors.
+        cea::BasicSampledTimer<cea::TscClock, 16> timer;
+        nanoseconds exact {0};
+        for(int i = 0; i < 20'000; ++i) {
+            const auto duration = (i % 3 == 0)? 3us : 1us;
+            exact += duration;
+            if(timer.shouldSample())
+                timer.record(duration);
+        }
+        const auto estimate = timer.estimate();
+        const auto error = relativeError(estimate.totalTime(), exact);
+        const bool ok =
+            timer.period() == 16 && estimate.calls == 20'000 &&
+            estimate.samples > 20'000 / 32 && estimate.samples < 20'000 / 8 &&
+            estimate.totalError() > 0ns &&
+            estimate.totalError() < estimate.totalTime() / 10 &&
+            error < 0.1;
+        cout << (ok? "OK" : "FAILED") << " (" << 100 * error
+             << "% off, exact " << exact << ")" << endl;
+        estimate.print(cout);
+        assert(ok);
+    }
+
+    cout << "- Constant durations are estimated exactly: ";
+    {
+        cea::BasicSampledTimer<cea::TscClock, 16> timer;
+        for(int i = 0; i < 20'000; ++i)
+            if(timer.shouldSample())
+                timer.record(2us);
+        const auto estimate = timer.estimate();
+        const bool ok = estimate.totalTime() == 40ms &&
+                        estimate.mean() == 2us &&
+                        estimate.totalError() == 0ns;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- measure() times real regions: ";
+    {
+        // Only loose bounds: a region spinning 2 us lasts at least that.
+        cea::BasicSampledTimer<cea::TscClock, 4> timer;
+        for(int i = 0; i < 2'000; ++i) {
+            const auto sample = timer.measure();
+            spin(2us);
+        }
+        const auto estimate = timer.estimate();
+        const bool ok = estimate.calls == 2'000 && estimate.samples > 0 &&
+                        estimate.mean() >= 1us;
+        cout << (ok? "OK" : "FAILED") << endl;
+        estimate.print(cout);
+        assert(ok);
+    }
+
+    cout << "- Alternating paths are not aliased: ";
+    {
+        cea::BasicSampledTimer<cea::TscClock, 2> timer;
+        for(int i = 0; i < 20'000; ++i)
+            if(timer.shouldSample())
+                timer.record(i % 2 == 0? 2us : 0us);
+        const auto mean = timer.estimate().mean();
+        const bool ok = mean > 700ns && mean < 1300ns;
+        cout << (ok? "OK" : "FAILED") << " (mean " << mean << ")" << endl;
+        assert(ok);
+    }
+
+    cout << "- Adaptive period meets the overhead budget: ";
+    {
+        constexpr double budget = 0.01;
+        cea::SampledTimer timer(budget);
+        const auto read = cea::ClockCalibration::of<cea::TscClock>()
+                          .read_overhead;
+        for(int i = 0; i < 2'000'000; ++i)
+            if(timer.shouldSample())
+                timer.record(20ns);
+        const auto estimate = timer.estimate();
+
+        // The smallest period keeping two clock reads per sample within
+        // the budget of the 20 ns calls.
+        const auto sample_cost = 2.0 * static_cast<double>(read.count());
+        const auto expected = static_cast<std::uint64_t>(std::clamp(
+            std::ceil(sample_cost / (budget * 20.0)), 1.0,
+            static_cast<double>(cea::SampledTimer::max_period)));
+        const auto overhead = sample_cost /
+            (static_cast<double>(timer.period()) * 20.0);
+        const bool ok = timer.period() == expected &&
+                        overhead <= budget &&
+                        estimate.totalTime() == 40ms &&
+                        estimate.samples <=
+                            4 * estimate.calls / expected + 1;
+        cout << (ok? "OK" : "FAILED") << " (1 in " << timer.period()
+             << ", " << 100 * overhead << "% overhead)" << endl;
+        estimate.print(cout);
+        assert(ok);
+    }
+
+    cout << "- Estimates of threads add up: ";
+    {
+        cea::SampledEstimate total;
+        for(const auto duration : {1us, 4us}) {
+            std::thread worker([&total, duration] {
+                cea::BasicSampledTimer<cea::TscClock, 8> timer;
+                for(int i = 0; i < 4'000; ++i)
+                    if(timer.shouldSample())
+                        timer.record(duration);
+                total += timer.estimate();
+            });
+            worker.join();
+        }
+        const bool ok = total.calls == 8'000 && total.totalTime() == 20ms &&
+                        total.mean() == 2500ns && total.totalError() == 0ns;
+        cout << (ok? "OK" : "FAILED") << endl;
+        total.print(cout);
+        assert(ok);
+    }
+
+    cout << "- Reset and manual recording: ";
+    {
+        cea::BasicSampledTimer<cea::TscClock, 4> timer;
+        for(int i = 0; i < 100; ++i)
+            if(timer.shouldSample())
+                timer.record(10us);
+        bool ok = timer.estimate().totalTime() == 1ms;
+        timer.reset();
+        ok = ok && timer.estimate().calls == 0 &&
+             timer.estimate().totalTime() == 0ns;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
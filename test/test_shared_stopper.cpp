@@ -0,0 +1,254 @@
+/******************************************************************************
+ * @file test_shared_stopper.cpp
+ * @brief Testing code for the SharedStopper class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/shared_stopper.hpp"
+
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <stop_token>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    #include <sys/wait.h>
+#endif
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//-------------------------------[ Workers ]----------------------------------//
+
+#if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+// Forks `num_workers` processes that spin until the stopper expires, the
+// first one expiring it itself if `first_expires`. Returns their ids.
+std::vector<pid_t> forkWorkers(cea::SharedStopper& shared, int num_workers,
+                               bool first_expires = false) {
+    std::vector<pid_t> workers;
+    for(int i = 0; i < num_workers; ++i) {
+        const auto pid = ::fork();
+        if(pid == 0) {
+            if(i == 0 && first_expires)
+                shared.expire();
+            // Bounded, so a broken stopper does not hang the test.
+            const auto begin = steady_clock::now();
+            while(!shared.isExpired())
+                if(steady_clock::now() - begin > 10s)
+                    ::_exit(1);
+            ::_exit(0);
+        }
+        workers.push_back(pid);
+    }
+    return workers;
+}
+
+// Waits for the workers, and returns true if all of them exited cleanly.
+bool joinWorkers(const std::vector<pid_t>& workers) {
+    bool ok = true;
+    for(const auto pid : workers) {
+        int status = 0;
+        ok = ::waitpid(pid, &status, 0) == pid && ok &&
+             WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    return ok;
+}
+#endif
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- An unshared stopper never expires: ";
+    {
+        cea::SharedStopper shared;
+        shared.expire();
+        const bool ok = !shared.isShared() && !shared.isExpired() &&
+                        shared.remaining() == nanoseconds::max();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    cout << "- Expiring in the parent stops the forked workers: ";
+    {
+        cea::SharedStopper shared;
+        bool ok = shared.create() && !shared.isExpired();
+        const auto workers = forkWorkers(shared, 4);
+        std::this_thread::sleep_for(20ms);
+        shared.expire();
+        ok = joinWorkers(workers) && ok && shared.isExpired() &&
+             shared.expiredBy() == ::getpid();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Any worker can expire the stopper for all: ";
+    {
+        cea::SharedStopper shared;
+        bool ok = shared.create();
+        const auto workers = forkWorkers(shared, 4, true);
+        const auto expirer = workers.front();
+        ok = joinWorkers(workers) && ok && shared.isExpired() &&
+             shared.expiredBy() == expirer;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- A bound watchdog enforces the shared deadline: ";
+    {
+        cea::StopScope scope;
+        scope.start();
+        cea::SharedStopper shared;
+        bool ok = shared.create();
+        shared.setExpirationTime(50ms);
+        ok = ok && shared.remaining() > 0ns && shared.remaining() <= 50ms;
+        shared.bind(scope);
+        const auto begin = steady_clock::now();
+        const auto workers = forkWorkers(shared, 2);
+        ok = joinWorkers(workers) && ok && scope.waitFor(1s);
+        const auto elapsed = steady_clock::now() - begin;
+        ok = ok && elapsed >= 45ms && elapsed < 2s &&
+             shared.remaining() == 0ns;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- The bound scope expires the workers, and vice versa: ";
+    {
+        cea::StopScope scope;
+        scope.setExpirationTime(30ms);
+        scope.start();
+        cea::SharedStopper shared;
+        bool ok = shared.create();
+        shared.bind(scope);
+        ok = joinWorkers(forkWorkers(shared, 2)) && ok && scope.isExpired();
+
+        // A new run: the workers expire the scope now.
+        scope.setExpirationTime(10s);
+        scope.start();
+        shared.reset();
+        ok = ok && !scope.isExpired();
+        ok = joinWorkers(forkWorkers(shared, 2, true)) && ok &&
+             scope.waitFor(1s);
+        shared.unbind();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Unbinding and destroying while a poll runs: ";
+    {
+        cea::StopScope scope;
+        scope.start();
+        std::atomic<int> running {0};
+        // Keeps the poll busy in the watchdog, expiring the scope.
+        std::stop_callback slow {scope.stopToken(), [&] {
+            running.store(1);
+            std::this_thread::sleep_for(20ms);
+        }};
+        auto shared = std::make_unique<cea::SharedStopper>();
+        bool ok = shared->create();
+        shared->bind(scope);
+        shared->expire();
+        while(running.load() == 0)
+            std::this_thread::yield();
+        shared->unbind();
+        std::this_thread::sleep_for(10ms);
+        ok = ok && scope.isExpired() && shared->isExpired();
+
+        // Again, destroying the stopper this time.
+        scope.start();
+        running.store(0);
+        std::stop_callback slow_again {scope.stopToken(), [&] {
+            running.store(1);
+            std::this_thread::sleep_for(20ms);
+        }};
+        shared->reset();
+        shared->bind(scope);
+        shared->expire();
+        while(running.load() == 0)
+            std::this_thread::yield();
+        shared.reset();
+        std::this_thread::sleep_for(10ms);
+        ok = ok && scope.isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- checkDeadline() expires without a watchdog: ";
+    {
+        cea::SharedStopper shared;
+        bool ok = shared.create();
+        shared.setExpirationTime(20ms);
+        ok = ok && !shared.checkDeadline();
+        std::this_thread::sleep_for(30ms);
+        ok = ok && shared.checkDeadline() && shared.isExpired();
+        shared.reset();
+        ok = ok && !shared.isExpired() &&
+             shared.remaining() == nanoseconds::max();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Named segments are shared by name: ";
+    {
+        const auto name = "/cea_timer_test_" + std::to_string(::getpid());
+        cea::SharedStopper creator, opener, missing;
+        bool ok = creator.create(name.c_str()) && opener.open(name.c_str());
+        ok = ok && !opener.isExpired();
+        creator.expire();
+        ok = ok && opener.isExpired();
+        ok = cea::SharedStopper::unlink(name.c_str()) && ok &&
+             !missing.open(name.c_str()) && opener.isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Mapped files are shared by path: ";
+    {
+        const auto path = "/tmp/cea_timer_test_" + std::to_string(::getpid());
+        bool ok = true;
+        {
+            cea::SharedStopper first, second;
+            ok = first.openFile(path.c_str()) &&
+                 second.openFile(path.c_str());
+            first.reset();
+            second.setExpirationTime(10s);
+            ok = ok && first.remaining() > 9s && !first.isExpired();
+            second.expire();
+            ok = ok && first.isExpired();
+        }
+        // The state persists in the file.
+        cea::SharedStopper reopened;
+        ok = reopened.openFile(path.c_str()) && ok && reopened.isExpired();
+        reopened.close();
+        ::unlink(path.c_str());
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+    #endif
+
+    cout << "All tests passed";
+    return 0;
+}
@@ -0,0 +1,370 @@
+/******************************************************************************
+ * @file test_stop_scope.cpp
+ * @brief Testing code for the StopScope class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/execution_stopper.hpp"
+#include "timer/stop_scope.hpp"
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <csignal>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    #include <poll.h>
+#endif
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//--------------------------[ Coroutine helpers ]-----------------------------//
+
+// A fire-and-forget coroutine, enough to drive the awaitables.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { abort(); }
+    };
+};
+
+// Sleeps in the scope, and records the result and when it finished.
+Detached sleeper(cea::StopScope& scope, std::chrono::nanoseconds duration,
+                 std::atomic<int>& result,
+                 std::chrono::steady_clock::time_point& finished) {
+    const bool expired = co_await scope.sleepFor(duration);
+    finished = std::chrono::steady_clock::now();
+    result.store(expired? 1 : 0);
+    result.notify_all();
+}
+
+// Waits for the scope expiration, and records when it happened.
+Detached expiryWaiter(cea::StopScope& scope, std::atomic<int>& result,
+                      std::chrono::steady_clock::time_point& finished) {
+    co_await scope.expired();
+    finished = std::chrono::steady_clock::now();
+    result.store(1);
+    result.notify_all();
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cea::StopScope global;
+    global.setExpirationTime(2s);
+    global.start();
+
+    cea::StopScope request {global};
+    cea::StopScope subtask {request};
+    assert(request.parent() == &global);
+    assert(subtask.parent() == &request);
+
+    cout << "- Child with its own 200ms budget; sleep 300ms..." << endl;
+    request.setExpirationTime(200ms);
+    request.start();
+    subtask.start();
+    std::this_thread::sleep_for(300ms);
+
+    cout
+    << "- Child and grandchild expired, parent not: "
+    << ((request.isExpired() && subtask.isExpired() &&
+         !global.isExpired())? "OK" : "FAILED")
+    << endl;
+    assert(request.isExpired());
+    assert(subtask.isExpired());
+    assert(!global.isExpired());
+
+    cout << "- Restart the child and expire the parent explicitly..." << endl;
+    request.setExpirationTime(10s);
+    request.start();
+    subtask.start();
+    assert(!request.isExpired());
+    assert(!subtask.isExpired());
+    global.expire();
+    cout
+    << "- Every descendant expired with the parent: "
+    << ((request.isExpired() && subtask.isExpired())? "OK" : "FAILED")
+    << endl;
+    assert(request.isExpired());
+    assert(subtask.isExpired());
+
+    cout << "- Children of expired scopes are born expired: ";
+    {
+        cea::StopScope late {global};
+        late.start();
+        cout << (late.isExpired()? "OK" : "FAILED") << endl;
+        assert(late.isExpired());
+    }
+
+    cout << "- Short-lived scopes created and destroyed in a loop..." << endl;
+    global.start();
+    for(int i = 0; i < 1000; ++i) {
+        cea::StopScope temp {global};
+        temp.setExpirationTime(std::chrono::microseconds {i % 7});
+        temp.start();
+    }
+    assert(!global.isExpired());
+
+    cout << "- waitFor() times out while the scope is alive: ";
+    {
+        cea::StopScope scope {global};
+        scope.start();
+        const auto begin = std::chrono::steady_clock::now();
+        const bool expired = scope.waitFor(50ms);
+        const auto waited = std::chrono::steady_clock::now() - begin;
+        cout << ((!expired && waited >= 50ms)? "OK" : "FAILED") << endl;
+        assert(!expired);
+        assert(waited >= 50ms);
+    }
+
+    cout << "- Waiters wake up as soon as the scope expires: ";
+    {
+        cea::StopScope scope {global};
+        scope.setExpirationTime(100ms);
+        scope.start();
+
+        std::chrono::steady_clock::time_point woke_for, woke_until;
+        bool expired_for = false;
+        std::thread waiter_for {[&] {
+            expired_for = scope.waitFor(10s);
+            woke_for = std::chrono::steady_clock::now();
+        }};
+        std::thread waiter_until {[&] {
+            scope.waitUntilExpired();
+            woke_until = std::chrono::steady_clock::now();
+        }};
+        const auto begin = std::chrono::steady_clock::now();
+        waiter_for.join();
+        waiter_until.join();
+
+        cout
+        << ((expired_for && woke_for - begin < 1s &&
+             woke_until - begin < 1s)? "OK" : "FAILED")
+        << endl;
+        assert(expired_for);
+        assert(woke_for - begin < 1s);
+        assert(woke_until - begin < 1s);
+        assert(scope.waitFor(1s));
+    }
+
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    cout << "- expiryFd() becomes readable on expiration: ";
+    {
+        const auto readable = [](int fd, int timeout_ms) {
+            pollfd entry {fd, POLLIN, 0};
+            return ::poll(&entry, 1, timeout_ms) == 1 &&
+                   (entry.revents & POLLIN) != 0;
+        };
+
+        cea::StopScope scope {global};
+        scope.setExpirationTime(50ms);
+        scope.start();
+        const int fd = scope.expiryFd();
+        assert(fd != -1);
+        assert(fd == scope.expiryFd());
+        assert(!readable(fd, 0));
+
+        const auto begin = std::chrono::steady_clock::now();
+        const bool woke = readable(fd, 1000);
+        const auto waited = std::chrono::steady_clock::now() - begin;
+        cout << ((woke && scope.isExpired() && waited < 1s)? "OK" : "FAILED")
+             << endl;
+        assert(woke);
+        assert(scope.isExpired());
+
+        // Stays readable until restarted.
+        assert(readable(fd, 0));
+        scope.setExpirationTime(10s);
+        scope.start();
+        assert(!readable(fd, 0));
+        scope.expire();
+        assert(readable(fd, 0));
+
+        // A descriptor asked for after expiration is readable right away.
+        cea::StopScope late {global};
+        late.expire();
+        assert(readable(late.expiryFd(), 0));
+    }
+    #endif
+
+    cout << "- co_await sleepFor() sleeps the whole duration: ";
+    {
+        cea::StopScope scope {global};
+        scope.start();
+        std::atomic<int> result {-1};
+        std::chrono::steady_clock::time_point finished;
+        const auto begin = std::chrono::steady_clock::now();
+        sleeper(scope, 50ms, result, finished);
+        result.wait(-1);
+        cout << ((result == 0 && finished - begin >= 50ms)? "OK" : "FAILED")
+             << endl;
+        assert(result == 0);
+        assert(finished - begin >= 50ms);
+    }
+
+    cout << "- co_await expired() and sleepFor() resume on expiration: ";
+    {
+        cea::StopScope scope {global};
+        scope.setExpirationTime(100ms);
+        scope.start();
+        std::atomic<int> slept {-1}, waited {-1};
+        std::chrono::steady_clock::time_point slept_at, waited_at;
+        const auto begin = std::chrono::steady_clock::now();
+        sleeper(scope, 10s, slept, slept_at);
+        expiryWaiter(scope, waited, waited_at);
+        slept.wait(-1);
+        waited.wait(-1);
+        cout << ((slept == 1 && slept_at - begin < 1s &&
+                  waited_at - begin < 1s)? "OK" : "FAILED")
+             << endl;
+        assert(slept == 1);
+        assert(slept_at - begin >= 100ms);
+        assert(slept_at - begin < 1s);
+        assert(waited_at - begin < 1s);
+
+        // Already expired: no suspension at all.
+        std::atomic<int> again {-1};
+        expiryWaiter(scope, again, waited_at);
+        assert(again == 1);
+    }
+
+    cout << "- Many sleeping coroutines, cut short by expiration: ";
+    {
+        constexpr int num_coroutines = 1000;
+        cea::StopScope scope {global};
+        scope.setExpirationTime(100ms);
+        scope.start();
+        std::vector<std::atomic<int>> results(num_coroutines);
+        std::vector<std::chrono::steady_clock::time_point>
+            finished(num_coroutines);
+        for(int i = 0; i < num_coroutines; ++i) {
+            results[i].store(-1);
+            // Half finish their sleep, half are cut short.
+            sleeper(scope, (i % 2 == 0)? 10ms : 10s, results[i], finished[i]);
+        }
+        bool ok = true;
+        for(int i = 0; i < num_coroutines; ++i) {
+            results[i].wait(-1);
+            ok = ok && (results[i] == ((i % 2 == 0)? 0 : 1));
+        }
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Stop tokens are stopped on expiration, and renewed by start(): ";
+    {
+        cea::StopScope scope {global};
+        scope.setExpirationTime(50ms);
+        scope.start();
+        auto token = scope.stopToken();
+        assert(!token.stop_requested());
+
+        std::atomic<bool> called {false};
+        std::stop_callback callback {token, [&] {
+            called.store(true);
+            called.notify_all();
+        }};
+        std::jthread worker {[token] {
+            while(!token.stop_requested())
+                std::this_thread::sleep_for(1ms);
+        }};
+        called.wait(false);
+        worker.join();
+        cout << ((called && token.stop_requested() && scope.isExpired())?
+                 "OK" : "FAILED") << endl;
+        assert(token.stop_requested());
+        assert(scope.isExpired());
+
+        scope.setExpirationTime(10s);
+        scope.start();
+        assert(token.stop_requested());
+        assert(!scope.stopToken().stop_requested());
+        scope.expire();
+        assert(scope.stopToken().stop_requested());
+
+        // Children of expired scopes hand out stopped tokens.
+        cea::StopScope child {scope};
+        assert(child.stopToken().stop_requested());
+    }
+
+    cout << "- Stop callbacks may destroy their scope, or use the parent: ";
+    {
+        cea::StopScope scope {global};
+        scope.start();
+        auto child = std::make_unique<cea::StopScope>(scope);
+        std::optional<cea::StopScope> grandchild;
+        bool parent_token_stopped = false;
+        std::stop_callback destroy {child->stopToken(), [&] {
+            child.reset();
+            parent_token_stopped = scope.stopToken().stop_requested();
+            grandchild.emplace(scope);
+        }};
+        scope.expire();
+        assert(!child);
+        assert(parent_token_stopped);
+        assert(grandchild->isExpired());
+        cout << "OK" << endl;
+    }
+
+    cout << "- elapsedApprox() follows the coarse timestamp: ";
+    {
+        static_assert(alignof(cea::StopScope) >= cea::cache_line_size);
+
+        cea::StopScope scope {global};
+        scope.start();
+        scope.elapsedApprox();  // Starts the coarse updates.
+        std::this_thread::sleep_for(100ms);
+        const auto approx = scope.elapsedApprox();
+        const auto exact = scope.elapsedInNanoseconds();
+        cout << approx << " vs " << exact << ": "
+             << ((approx <= exact && exact - approx < 20ms)? "OK" : "FAILED")
+             << endl;
+        assert(approx <= exact);
+        assert(exact - approx < 20ms);
+
+        scope.stop();
+        std::this_thread::sleep_for(5ms);
+        assert(scope.elapsedApprox() == scope.elapsedInNanoseconds());
+    }
+
+    cout << "- Children of the ExecutionStopper root expire on Ctrl-C: ";
+    cea::ExecutionStopper::setExpirationTime(10s);
+    cea::ExecutionStopper::start();
+    cea::StopScope phase {cea::ExecutionStopper::root()};
+    phase.start();
+    assert(!phase.isExpired());
+    std::raise(SIGINT);
+    cout << (phase.waitFor(1s)? "OK" : "FAILED") << endl;
+    assert(cea::ExecutionStopper::isExpired());
+    assert(phase.isExpired());
+
+    cout << "All tests passed";
+    return 0;
+}
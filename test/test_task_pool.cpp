@@ -0,0 +1,167 @@
+/******************************************************************************
+ * @file test_task_pool.cpp
+ * @brief Testing code for the TaskPool class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/stop_scope.hpp"
+#include "timer/task_pool.hpp"
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cea::StopScope scope;
+    scope.start();
+    cea::TaskPool pool(4, scope);
+
+    cout << "- parallelFor() runs every iteration once: ";
+    {
+        std::vector<std::atomic<int>> visits(10'000);
+        const auto progress = pool.parallelFor(0, 10'000,
+            [&visits](int i) { visits[i].fetch_add(1); });
+        bool ok = pool.numThreads() == 4 && progress.isComplete() &&
+                  progress.completed == 10'000;
+        for(const auto& visit : visits)
+            ok = ok && visit.load() == 1;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- parallelReduce() combines in the order of the range: ";
+    {
+        const auto sum = pool.parallelReduce(std::int64_t {1},
+            std::int64_t {100'001}, std::int64_t {0},
+            [](std::int64_t i) { return i; },
+            [](std::int64_t a, std::int64_t b) { return a + b; }, 100);
+
+        // Concatenation is associative, but not commutative.
+        const auto digits = pool.parallelReduce(0, 50, std::string {},
+            [](int i) { return std::to_string(i % 10); },
+            [](std::string a, const std::string& b) { return a + b; }, 3);
+        std::string expected;
+        for(int i = 0; i < 50; ++i)
+            expected += std::to_string(i % 10);
+
+        const bool ok = sum.isComplete() &&
+                        sum.value == std::int64_t {100'000} * 100'001 / 2 &&
+                        digits.isComplete() && digits.value == expected;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Empty ranges do nothing: ";
+    {
+        const auto progress = pool.parallelFor(5, 5, [](int) { abort(); });
+        const auto result = pool.parallelReduce(5, 2, 42,
+            [](int) { return 0; }, [](int a, int b) { return a + b; });
+        const bool ok = progress.isComplete() && progress.total == 0 &&
+                        result.total == 0 && result.value == 42;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Loops can be nested inside tasks: ";
+    {
+        std::atomic<int> count {0};
+        const auto progress = pool.parallelFor(0, 16, [&](int) {
+            pool.parallelFor(0, 100, [&count](int) { count.fetch_add(1); },
+                             10);
+        }, 1);
+        const bool ok = progress.isComplete() && count.load() == 1600;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- On expiration, queued tasks are dropped: ";
+    {
+        // One iteration per task; the 100th to run expires the scope.
+        std::atomic<int> ran {0};
+        const auto dropped_before = pool.numDropped();
+        const auto result = pool.parallelReduce(0, 10'000, 0,
+            [&](int) {
+                if(ran.fetch_add(1) == 99)
+                    scope.expire();
+                return 1;
+            },
+            [](int a, int b) { return a + b; }, 1);
+        const auto dropped = pool.numDropped() - dropped_before;
+        const bool ok = scope.isExpired() && !result.isComplete() &&
+                        result.completed == static_cast<std::size_t>(
+                            ran.load()) &&
+                        result.value == ran.load() &&
+                        result.completed + dropped == 10'000 &&
+                        result.completed < 1000;
+        cout << (ok? "OK" : "FAILED") << " (" << result.completed
+             << " of " << result.total << " iterations)" << endl;
+        assert(ok);
+    }
+
+    cout << "- Nothing runs in an expired scope: ";
+    {
+        const auto progress = pool.parallelFor(0, 1000, [](int) { abort(); });
+        const bool ok = progress.completed == 0 && progress.total == 1000;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- The deadline stops a long loop with a partial result: ";
+    {
+        scope.setExpirationTime(50ms);
+        scope.start();
+        const auto begin = std::chrono::steady_clock::now();
+        const auto result = pool.parallelReduce(0, 100'000, 0,
+            [](int) {
+                std::this_thread::sleep_for(100us);
+                return 1;
+            },
+            [](int a, int b) { return a + b; }, 10);
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        const bool ok = !result.isComplete() && result.completed > 0 &&
+                        result.value ==
+                            static_cast<int>(result.completed) &&
+                        elapsed < 1s;
+        cout << (ok? "OK" : "FAILED") << " (" << result.completed
+             << " of " << result.total << " iterations)" << endl;
+        assert(ok);
+    }
+
+    cout << "- The pool runs again once the scope restarts: ";
+    {
+        scope.setExpirationTime(10s);
+        scope.start();
+        const auto progress = pool.parallelFor(0, 1000, [](int) {});
+        cout << (progress.isComplete()? "OK" : "FAILED") << endl;
+        assert(progress.isComplete());
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
@@ -6,10 +6,11 @@
  * SPDX-License-Identifier: BSD-3-Clause.
  *
  * Created on : 2015-06-17 by ceandrade.
- * Last update: 2026-07-26 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
  ******************************************************************************/
 
 #include "timer/timer.hpp"
+#include "timer/virtual_clock.hpp"
 
 #include <iostream>
 #include <chrono>
@@ -33,7 +34,10 @@ using namespace std::chrono_literals;
 //--------------------------------[ Main ]------------------------------------//
 
 int main() {
-    cea::Timer timer;
+    // The clock is advanced by hand, so the test does not sleep.
+    cea::VirtualClock::enable();
+    using clock = cea::VirtualClock;
+    cea::BasicTimer<clock> timer;
 
     cout
     << "- After instantiation, the timer must be stopped: "
@@ -54,15 +58,15 @@ int main() {
     << endl;
     assert(!timer.isStopped());
 
-    cout << "- Sleep for 2 seconds..." << endl;
-    std::this_thread::sleep_for(2s);
+    cout << "- Advance 2 seconds..." << endl;
+    clock::advance(2s);
     cout << "- Elapsed time: " << timer.elapsed() << endl;
-    assert(timer.elapsed() < 2.1s);
+    assert(timer.elapsedInNanoseconds() == 2s);
 
-    cout << "- Sleep for more 2 seconds..." << endl;
-    std::this_thread::sleep_for(2s);
+    cout << "- Advance more 2 seconds..." << endl;
+    clock::advance(2s);
     cout << "- Elapsed time: " << timer.elapsed() << endl;
-    assert(timer.elapsed() < 4.1s);
+    assert(timer.elapsedInNanoseconds() == 4s);
 
     timer.stop();
     auto elapsed = timer.elapsed();
@@ -72,16 +76,36 @@ int main() {
 
     cout << "- Elapsed time: " << timer.elapsed() << endl;
 
-    cout << "- Sleep for 5 seconds..." << endl;
-    std::this_thread::sleep_for(5s);
+    cout << "- Advance 5 seconds..." << endl;
+    clock::advance(5s);
     cout << "- Elapsed time: " << timer.elapsed() << endl;
-    assert(timer.elapsed() - elapsed <= 0s);
+    assert(timer.elapsed() - elapsed == 0s);
 
-    cout << "- Resume the timer, and sleep for more 2 seconds..." << endl;
+    cout << "- Resume the timer, and advance more 2 seconds..." << endl;
     timer.resume();
-    std::this_thread::sleep_for(2s);
+    clock::advance(2s);
     cout << "- Elapsed time: " << timer.elapsed() << endl;
-    assert(timer.elapsed() < 6.1s);
+    assert(timer.elapsedInNanoseconds() == 6s);
+
+    cout << "- Start resets the timer: ";
+    timer.start();
+    clock::advance(1500ms);
+    cout << (timer.elapsedInNanoseconds() == 1500ms? "OK" : "FAILED") << endl;
+    assert(timer.elapsedInNanoseconds() == 1500ms);
+
+    cout << "- The steady clock timer measures real time: ";
+    {
+        cea::Timer steady_timer;
+        steady_timer.start();
+        std::this_thread::sleep_for(20ms);
+        steady_timer.stop();
+        const auto measured = steady_timer.elapsedInNanoseconds();
+        std::this_thread::sleep_for(10ms);
+        const bool ok = measured >= 20ms && measured < 1s &&
+                        steady_timer.elapsedInNanoseconds() == measured;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
 
     cout << "All tests passed";
     return 0;
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * @file test_timing_wheel.cpp
+ * @brief Testing code for the TimingWheel and DeadlineService classes.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/deadline_service.hpp"
+#include "timer/timing_wheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+struct TestNode: public cea::TimingWheelNode {
+    std::int64_t tick {0};
+    std::int64_t fired_at {-1};
+};
+
+struct FlagNode: public cea::DeadlineNode {
+    std::atomic<bool> fired {false};
+    void onDeadline() noexcept override {
+        fired.store(true);
+    }
+};
+
+// Schedules itself again at the end of each call, after a while.
+struct RepeatingNode: public cea::DeadlineNode {
+    std::atomic<bool> running {false};
+    std::atomic<int> calls {0};
+    void onDeadline() noexcept override {
+        running.store(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds {20});
+        calls.fetch_add(1);
+        cea::DeadlineService::instance().schedule(*this,
+            cea::DeadlineService::now());
+    }
+};
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    std::mt19937_64 rng {2026};
+
+    cout << "- Wheel: nodes spread over every level fire exactly on time: ";
+    {
+        const std::int64_t start = 123'456'789;
+        cea::TimingWheel wheel {start};
+        std::vector<TestNode> nodes(20'000);
+
+        for(std::size_t i = 0; i < nodes.size(); ++i) {
+            // Deltas from 0 to beyond the wheel range, log-uniformly.
+            const auto bits = rng() % 36;
+            const auto delta =
+                static_cast<std::int64_t>(rng() % (std::uint64_t {1} << bits));
+            nodes[i].tick = start + delta;
+            wheel.insert(nodes[i], nodes[i].tick);
+        }
+        assert(wheel.size() == nodes.size());
+
+        // Cancel one node out of ten.
+        for(std::size_t i = 0; i < nodes.size(); i += 10)
+            wheel.remove(nodes[i]);
+
+        // Advance in random steps, from small to very large.
+        std::int64_t now = start;
+        while(!wheel.empty()) {
+            now += static_cast<std::int64_t>(
+                rng() % (std::uint64_t {1} << (rng() % 30)));
+            wheel.advance(now);
+            while(auto* node = wheel.popExpired()) {
+                auto* test_node = static_cast<TestNode*>(node);
+                assert(test_node->fired_at == -1);
+                assert(test_node->tick <= now);
+                test_node->fired_at = now;
+            }
+            // Nothing due may remain in the wheel.
+            assert(wheel.nextEventTick() > now);
+        }
+
+        for(std::size_t i = 0; i < nodes.size(); ++i) {
+            if(i % 10 == 0) {
+                assert(nodes[i].fired_at == -1);
+                continue;
+            }
+            assert(nodes[i].fired_at >= nodes[i].tick);
+        }
+        cout << "OK" << endl;
+    }
+
+    cout << "- Wheel: advancing tick by tick fires at the exact tick: ";
+    {
+        cea::TimingWheel wheel {0};
+        std::vector<TestNode> nodes(5'000);
+        for(auto& node : nodes) {
+            node.tick = static_cast<std::int64_t>(rng() % 200'000);
+            wheel.insert(node, node.tick);
+        }
+        for(std::int64_t now = 1; !wheel.empty(); ++now) {
+            wheel.advance(now);
+            while(auto* node = wheel.popExpired())
+                static_cast<TestNode*>(node)->fired_at = now;
+        }
+        for(const auto& node : nodes)
+            assert(node.fired_at == std::max<std::int64_t>(node.tick, 1));
+        cout << "OK" << endl;
+    }
+
+    cout << "- Service: deadlines fire, cancelled ones do not: ";
+    {
+        auto& service = cea::DeadlineService::instance();
+        std::vector<FlagNode> nodes(1'000);
+        const auto now = cea::DeadlineService::now();
+        for(std::size_t i = 0; i < nodes.size(); ++i)
+            service.schedule(nodes[i],
+                now + static_cast<std::int64_t>(i % 50) * 1'000'000);
+        for(std::size_t i = 0; i < nodes.size(); i += 2)
+            service.cancel(nodes[i]);
+
+        std::this_thread::sleep_for(100ms);
+        for(std::size_t i = 0; i < nodes.size(); ++i)
+            assert(nodes[i].fired.load() == (i % 2 == 1));
+
+        for(auto& node : nodes)
+            service.cancel(node);
+        cout << "OK" << endl;
+    }
+
+    cout << "- Service: a callback scheduling again is cancelled: ";
+    {
+        auto& service = cea::DeadlineService::instance();
+        auto node = std::make_unique<RepeatingNode>();
+        service.schedule(*node, cea::DeadlineService::now());
+        while(!node->running.load())
+            std::this_thread::yield();
+        // Cancel while the callback runs; it must not be linked again.
+        service.cancel(*node);
+        const auto calls = node->calls.load();
+        std::this_thread::sleep_for(50ms);
+        assert(node->calls.load() == calls);
+        node.reset();
+        cout << "OK" << endl;
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
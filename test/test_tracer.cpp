@@ -0,0 +1,161 @@
+/******************************************************************************
+ * @file test_tracer.cpp
+ * @brief Testing code for the Tracer and TraceBuffer classes.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/execution_stopper.hpp"
+#include "timer/profiler.hpp"
+#include "timer/tracer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//------------------------------[ Test helpers ]------------------------------//
+
+// Number of occurrences of `pattern` in `text`.
+std::size_t occurrences(const std::string& text, const std::string& pattern) {
+    std::size_t count = 0;
+    for(auto position = text.find(pattern); position != std::string::npos;
+        position = text.find(pattern, position + 1))
+        ++count;
+    return count;
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    cout << "- Ring buffer keeps the order across threads: ";
+    {
+        static cea::TraceBuffer buffer {1};
+        constexpr std::int64_t num_events = 1'000'000;
+        std::int64_t pushed = 0;
+        std::thread producer {[&pushed] {
+            for(std::int64_t i = 0; i < num_events; ++i)
+                if(buffer.push({"event", "test", i, 'i'}))
+                    ++pushed;
+        }};
+
+        std::int64_t received = 0, last = -1;
+        bool ordered = true;
+        const auto consume = [&](const cea::TraceEvent& event) {
+            ordered = ordered && event.timestamp > last;
+            last = event.timestamp;
+            ++received;
+        };
+        while(received + static_cast<std::int64_t>(buffer.droppedEvents())
+              < num_events)
+            buffer.drain(consume);
+        producer.join();
+        buffer.drain(consume);
+
+        const bool ok = ordered && received == pushed &&
+            received + static_cast<std::int64_t>(buffer.droppedEvents()) ==
+                num_events;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Nothing is recorded while tracing is off: ";
+    {
+        cea::Tracer::begin("ignored");
+        cea::Tracer::end("ignored");
+        const bool ok = !cea::Tracer::isEnabled();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Regions and stopper events from several threads: ";
+    {
+        std::ostringstream trace;
+        assert(cea::Tracer::start(trace, 5ms));
+        assert(!cea::Tracer::start(trace));
+
+        cea::ExecutionStopper::setExpirationTime(1s);
+        cea::ExecutionStopper::start();
+        cea::ExecutionStopper::stop();
+        cea::ExecutionStopper::resume();
+
+        constexpr int num_threads = 3;
+        constexpr int num_calls = 100;
+        std::vector<std::thread> threads;
+        for(int i = 0; i < num_threads; ++i) {
+            threads.emplace_back([] {
+                for(int j = 0; j < num_calls; ++j) {
+                    cea::ProfileRegion outer {"worker"};
+                    cea::ProfileRegion inner {"step \"quoted\""};
+                }
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        cea::ExecutionStopper::root().expire();
+        cea::Tracer::stop();
+        const auto text = trace.str();
+
+        const bool ok =
+            text.starts_with("{\"traceEvents\":[") &&
+            text.ends_with("],\"displayTimeUnit\":\"ns\"}\n") &&
+            occurrences(text, "\"name\":\"worker\"") == 2 * num_threads *
+                                                        num_calls &&
+            occurrences(text, "\"name\":\"step \\\"quoted\\\"\"") ==
+                2 * num_threads * num_calls &&
+            occurrences(text, "\"ph\":\"B\"") ==
+                occurrences(text, "\"ph\":\"E\"") &&
+            occurrences(text, "\"cat\":\"ExecutionStopper\"") == 4 &&
+            occurrences(text, "\"name\":\"expire\"") == 1 &&
+            occurrences(text, "\"name\":\"resume\"") == 1 &&
+            cea::Tracer::droppedEvents() == 0;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Full buffers drop events instead of blocking: ";
+    {
+        std::ostringstream trace;
+        // The flusher sleeps longer than the producer takes to fill up.
+        assert(cea::Tracer::start(trace, 10s));
+        std::thread producer {[] {
+            for(std::size_t i = 0; i < 2 * cea::TraceBuffer::capacity; ++i)
+                cea::Tracer::instant("burst", "test");
+        }};
+        producer.join();
+        const auto dropped = cea::Tracer::droppedEvents();
+        cea::Tracer::stop();
+
+        const bool ok = dropped == cea::TraceBuffer::capacity &&
+            occurrences(trace.str(), "\"name\":\"burst\"") ==
+                cea::TraceBuffer::capacity;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
@@ -0,0 +1,261 @@
+/******************************************************************************
+ * @file test_virtual_clock.cpp
+ * @brief Testing code for the VirtualClock class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#include "timer/execution_stopper.hpp"
+#include "timer/stop_scope.hpp"
+#include "timer/timer.hpp"
+#include "timer/virtual_clock.hpp"
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <stop_token>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//-------------------------------[ Assert ]-----------------------------------//
+
+// In some compilers, the `assert` function in header <cassert>
+// is emptied defined. So, we just redefined it here
+// (literally, we copied the code from `assert.h`).
+#undef assert
+#undef __assert
+#define assert(e) \
+    ((void) ((e) ? ((void)0) : __assert (#e, __FILE__, __LINE__)))
+#define __assert(e, file, line) \
+    ((void)printf ("%s:%d: failed assertion `%s'\n", file, line, e), abort())
+
+//--------------------------[ Coroutine helpers ]-----------------------------//
+
+// A fire-and-forget coroutine, enough to drive the awaitables.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { abort(); }
+    };
+};
+
+// Sleeps in the scope, and records the result: 0 if woken up by the end of
+// the sleep, 1 if by the expiration of the scope.
+Detached sleeper(cea::StopScope& scope, std::chrono::nanoseconds duration,
+                 std::atomic<int>& result) {
+    const bool expired = co_await scope.sleepFor(duration);
+    result.store(expired? 1 : 0);
+}
+
+//--------------------------------[ Main ]------------------------------------//
+
+int main() {
+    using clock = cea::VirtualClock;
+
+    cout << "- Before enabling, the clock follows the steady clock: ";
+    {
+        const auto steady_before = std::chrono::steady_clock::now();
+        const auto now = clock::now();
+        const auto steady_after = std::chrono::steady_clock::now();
+        const bool ok =
+            !clock::isEnabled() &&
+            now.time_since_epoch() >= steady_before.time_since_epoch() &&
+            now.time_since_epoch() <= steady_after.time_since_epoch();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    clock::enable();
+
+    cout << "- Once enabled, the clock stands still on a tick: ";
+    {
+        const auto before = clock::now();
+        const auto after = clock::now();
+        const auto tick = std::chrono::nanoseconds {cea::DeadlineService::tick};
+        const bool ok = clock::isEnabled() && before == after &&
+                        before.time_since_epoch() % tick == 0ns;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Advancing moves it exactly: ";
+    {
+        const auto before = clock::now();
+        clock::advance(1234567ns);
+        const bool ok = clock::now() - before == 1234567ns;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- A timer on the clock measures the advances: ";
+    {
+        cea::BasicTimer<clock> timer;
+        timer.start();
+        clock::advance(3s);
+        timer.stop();
+        clock::advance(1s);
+        timer.resume();
+        clock::advance(250ms);
+        const bool ok = timer.elapsedInNanoseconds() == 3250ms;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    // Realign to a tick, as the previous advances may not have ended on one.
+    clock::advance(100us - clock::now().time_since_epoch() % 100us);
+
+    cout << "- A scope expires exactly at its budget: ";
+    {
+        cea::StopScope scope;
+        scope.setExpirationTime(1s);
+        scope.start();
+        clock::advance(1s - 1ns);
+        const bool before = scope.isExpired();
+        clock::advance(1ns);
+        const bool ok = !before && scope.isExpired() &&
+                        scope.elapsedInNanoseconds() == 1s;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Stopped time does not count towards the budget: ";
+    {
+        cea::StopScope scope;
+        scope.setExpirationTime(2s);
+        scope.start();
+        clock::advance(1500ms);
+        scope.stop();
+        clock::advance(10s);
+        const bool stopped = !scope.isExpired();
+        scope.resume();
+        clock::advance(400ms);
+        const bool resumed = !scope.isExpired();
+        clock::advance(100ms);
+        const bool ok = stopped && resumed && scope.isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Moving the deadline forward and back: ";
+    {
+        cea::StopScope scope;
+        scope.setExpirationTime(1s);
+        scope.start();
+        scope.setExpirationTime(3s);
+        clock::advance(2s);
+        const bool extended = !scope.isExpired();
+        scope.setExpirationTime(5s);
+        scope.setExpirationTime(2500ms);
+        clock::advance(499ms);
+        const bool before = scope.isExpired();
+        clock::advance(1ms);
+        const bool ok = extended && !before && scope.isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Child scopes expire with their parent: ";
+    {
+        cea::StopScope parent;
+        parent.setExpirationTime(1s);
+        parent.start();
+        cea::StopScope child(parent);
+        child.setExpirationTime(10s);
+        child.start();
+        clock::advance(1s);
+        const bool ok = parent.isExpired() && child.isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Stop callbacks have run when advance returns: ";
+    {
+        cea::StopScope scope;
+        scope.setExpirationTime(200ms);
+        scope.start();
+        std::atomic<bool> called {false};
+        std::stop_callback callback(scope.stopToken(), [&called] {
+            called.store(true);
+        });
+        clock::advance(199ms);
+        const bool before = called.load();
+        clock::advance(1ms);
+        const bool ok = !before && called.load();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Coroutine sleeps wake up on the virtual time: ";
+    {
+        cea::StopScope scope;
+        scope.setExpirationTime(1s);
+        scope.start();
+        std::atomic<int> slept {-1};
+        std::atomic<int> expired {-1};
+        sleeper(scope, 300ms, slept);
+        sleeper(scope, 10s, expired);
+        clock::advance(299ms);
+        const bool before = slept.load() == -1;
+        clock::advance(1ms);
+        const bool woke = slept.load() == 0 && expired.load() == -1;
+        clock::advance(700ms);
+        const bool ok = before && woke && expired.load() == 1;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    cout << "- CPU budgets are checked when advancing: ";
+    {
+        cea::ExecutionStopper::setExpirationTime(3600s);
+        assert(cea::ExecutionStopper::setCpuTimeBudget(20ms));
+        cea::ExecutionStopper::start();
+
+        // The CPU time is real, but the watchdog checks it on virtual time.
+        const auto begin = std::chrono::steady_clock::now();
+        while(cea::ExecutionStopper::cpuTimeUsed() < 30ms &&
+              std::chrono::steady_clock::now() - begin < 5s)
+            ;
+        const bool frozen = !cea::ExecutionStopper::isExpired();
+        clock::advance(20ms);
+        const bool ok = frozen && cea::ExecutionStopper::isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+        cea::ExecutionStopper::setCpuTimeBudget(0ns);
+    }
+    #endif
+
+    cout << "- Disabling continues from the virtual time: ";
+    {
+        const auto frozen = clock::now();
+        clock::disable();
+        const auto first = clock::now();
+        const auto second = clock::now();
+        const bool ok = !clock::isEnabled() && frozen <= first &&
+                        first <= second && first - frozen < 1s;
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "- Scopes run on real time again: ";
+    {
+        cea::StopScope scope;
+        scope.setExpirationTime(20ms);
+        scope.start();
+        const bool ok = scope.waitFor(2s) && scope.isExpired();
+        cout << (ok? "OK" : "FAILED") << endl;
+        assert(ok);
+    }
+
+    cout << "All tests passed";
+    return 0;
+}
@@ -0,0 +1,610 @@
+/******************************************************************************
+ * @file benchmark.hpp
+ * @brief Interface for the BenchmarkRunner class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/execution_stopper.hpp"
+#include "timer/stop_scope.hpp"
+#include "timer/timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cea {
+
+/**
+ * \brief Keep the compiler from optimizing `value` (and the computation
+ *        behind it) away.
+ */
+template <class T>
+inline void doNotOptimize(const T& value) noexcept {
+    #if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+    #else
+        const volatile auto* sink = &value;
+        (void) sink;
+    #endif
+}
+
+/**
+ * \brief BenchmarkOptions class.
+ *
+ * How BenchmarkRunner measures each benchmark.
+ */
+struct BenchmarkOptions {
+    /// Minimum time running the benchmark before measuring it.
+    std::chrono::nanoseconds warmup_time {std::chrono::milliseconds {100}};
+
+    /// Minimum duration of a sample; the number of iterations per sample is
+    /// scaled during the warm-up to reach it.
+    std::chrono::nanoseconds sample_time {std::chrono::milliseconds {10}};
+
+    /// Number of samples (repetitions) per benchmark.
+    std::size_t num_samples {30};
+
+    /// Confidence level of the interval of the median.
+    double confidence {0.95};
+
+    /// Samples beyond this many interquartile ranges from the quartiles
+    /// (Tukey's fences) are rejected as outliers. Zero keeps all samples.
+    double outlier_fence {1.5};
+};
+
+/**
+ * \brief BenchmarkResult class.
+ *
+ * The statistics of a benchmark, in nanoseconds per iteration, over the
+ * samples kept after rejecting the outliers.
+ */
+struct BenchmarkResult {
+    /// Name of the benchmark.
+    std::string name {};
+
+    /// Iterations per sample.
+    std::uint64_t iterations {0};
+
+    /// Samples kept.
+    std::size_t samples {0};
+
+    /// Samples rejected as outliers.
+    std::size_t outliers {0};
+
+    /// Median time per iteration.
+    double median {0.0};
+
+    /// Lower end of the confidence interval of the median.
+    double ci_low {0.0};
+
+    /// Upper end of the confidence interval of the median.
+    double ci_high {0.0};
+
+    /// Mean time per iteration.
+    double mean {0.0};
+
+    /// Standard deviation of the time per iteration.
+    double stddev {0.0};
+
+    /// Fastest sample.
+    double min {0.0};
+
+    /// Slowest sample.
+    double max {0.0};
+
+    /// False if the stop scope expired before all samples were taken.
+    bool complete {false};
+};
+
+/**
+ * \brief BenchmarkRunner class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Runs micro-benchmarks and summarizes them with robust statistics:
+ *
+ * \code
+ *     cea::BenchmarkRunner runner;
+ *     runner.run("sort 1k", [&] {
+ *         auto copy = data;
+ *         std::sort(copy.begin(), copy.end());
+ *         cea::doNotOptimize(copy);
+ *     });
+ *     runner.print(std::cout);
+ *     // sort 1k     21.402 us  [21.377 us, 21.455 us]  28 x 468  2 outliers
+ * \endcode
+ *
+ * Each benchmark is warmed up for BenchmarkOptions::warmup_time, while the
+ * number of iterations per sample grows until a sample takes at least
+ * BenchmarkOptions::sample_time, so the Timer resolution and the loop
+ * overhead become negligible. Then, BenchmarkOptions::num_samples samples
+ * are timed. Outliers (usually preemptions and interrupts) are rejected by
+ * Tukey's fences, and the median is reported with a distribution-free
+ * confidence interval, from the order statistics of the samples kept.
+ *
+ * Results are written as a table, JSON, or CSV. A CSV file of a previous run
+ * can be read back with readCsv() and compared with compare(), which flags
+ * the benchmarks whose confidence intervals no longer overlap the
+ * baseline's.
+ *
+ * The runner checks a StopScope, by default the ExecutionStopper, between
+ * samples, so a suite can run under a time budget or be interrupted by
+ * Ctrl-C: the benchmark in progress keeps the samples taken so far and is
+ * marked as incomplete, and the following ones are skipped.
+ */
+class BenchmarkRunner {
+public:
+    /** \name Constructor */
+    //@{
+    /**
+     * \brief Build a runner.
+     * \param options how to measure each benchmark.
+     * \param scope the runner stops when this scope expires.
+     */
+    explicit BenchmarkRunner(
+        const BenchmarkOptions& options = {},
+        const StopScope& scope = ExecutionStopper::root()
+    ):
+        benchmark_options {options},
+        stop_scope {scope},
+        benchmark_results {}
+    {}
+    //@}
+
+    /** Running */
+    //@{
+    /**
+     * \brief Measure `function`, called once per iteration, and keep its
+     *        result.
+     * \return the result, also kept in results().
+     */
+    template <class Function>
+    const BenchmarkResult& run(const std::string& name, Function&& function);
+
+    /// Return the results so far, in the order they were run.
+    const std::vector<BenchmarkResult>& results() const noexcept {
+        return benchmark_results;
+    }
+    //@}
+
+    /** Output */
+    //@{
+    /// Print the results as a table.
+    void print(std::ostream& output) const;
+
+    /// Write the results as a JSON object.
+    void writeJson(std::ostream& output) const;
+
+    /// Write the results as CSV, with a header line.
+    void writeCsv(std::ostream& output) const;
+
+    /**
+     * \brief Read results written by writeCsv().
+     * \return false, leaving `results` untouched, if the input is malformed.
+     */
+    static bool readCsv(std::istream& input,
+                        std::vector<BenchmarkResult>& results);
+
+    /**
+     * \brief Print the results next to those of a baseline with the same
+     *        names.
+     * \param tolerance ratios of the medians within 1 +- tolerance are not
+     *        flagged, even if the confidence intervals do not overlap.
+     * \return the number of benchmarks that got slower.
+     */
+    std::size_t compare(const std::vector<BenchmarkResult>& baseline,
+                        std::ostream& output, double tolerance = 0.02) const;
+    //@}
+
+protected:
+    /** \name Statistics */
+    //@{
+    /// Summarize the samples (nanoseconds per iteration) into `result`.
+    void summarize(std::vector<double> samples, BenchmarkResult& result) const;
+
+    /// Return the value at `fraction` (0 to 1) of sorted `values`,
+    /// interpolating between neighbors.
+    static double quantile(const std::vector<double>& values,
+                           double fraction) noexcept;
+
+    /// Return z such that a standard normal falls in [-z, z] with
+    /// probability `confidence`.
+    static double normalQuantile(double confidence) noexcept;
+    //@}
+
+    /** \name Formatting */
+    //@{
+    /// Return a time in nanoseconds with a suitable unit.
+    static std::string formatTime(double nanoseconds);
+
+    /// Write a string as a JSON string literal.
+    static void writeJsonString(std::ostream& output, const std::string& text);
+    //@}
+
+    /** \name Data members */
+    //@{
+    /// How to measure each benchmark.
+    BenchmarkOptions benchmark_options;
+
+    /// The runner stops when this scope expires.
+    const StopScope& stop_scope;
+
+    /// Results so far.
+    std::vector<BenchmarkResult> benchmark_results;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//--------------------------------[ Running ]---------------------------------//
+
+template <class Function>
+const BenchmarkResult& BenchmarkRunner::run(const std::string& name,
+                                            Function&& function) {
+    BenchmarkResult result;
+    result.name = name;
+
+    Timer timer;
+    const auto runBatch = [&](std::uint64_t iterations) {
+        timer.start();
+        for(std::uint64_t i = 0; i < iterations; ++i)
+            function();
+        timer.stop();
+        return timer.elapsedInNanoseconds();
+    };
+
+    // Warm up, growing the batch until it fills a sample. The growth is
+    // capped at 10x per step, so a slow first call does not overshoot.
+    const auto sample_time = std::max(benchmark_options.sample_time,
+                                      std::chrono::nanoseconds {1});
+    std::uint64_t iterations = 1;
+    std::chrono::nanoseconds warmed {0};
+    bool stopped = false;
+    while(true) {
+        if(stop_scope.isExpired()) {
+            stopped = true;
+            break;
+        }
+        const auto elapsed = runBatch(iterations);
+        warmed += elapsed;
+        if(elapsed >= sample_time) {
+            if(warmed >= benchmark_options.warmup_time)
+                break;
+            continue;
+        }
+        const auto scale = elapsed.count() <= 0? 10.0 :
+            std::min(10.0, 1.2 * static_cast<double>(sample_time.count()) /
+                           static_cast<double>(elapsed.count()));
+        iterations = std::max(iterations + 1, static_cast<std::uint64_t>(
+            static_cast<double>(iterations) * scale));
+    }
+    result.iterations = iterations;
+
+    std::vector<double> samples;
+    samples.reserve(benchmark_options.num_samples);
+    while(!stopped && samples.size() < benchmark_options.num_samples) {
+        if(stop_scope.isExpired()) {
+            stopped = true;
+            break;
+        }
+        samples.push_back(static_cast<double>(runBatch(iterations).count()) /
+                          static_cast<double>(iterations));
+    }
+    result.complete = !stopped;
+    summarize(std::move(samples), result);
+
+    benchmark_results.push_back(std::move(result));
+    return benchmark_results.back();
+}
+
+//-------------------------------[ Statistics ]-------------------------------//
+
+inline void BenchmarkRunner::summarize(std::vector<double> samples,
+                                       BenchmarkResult& result) const {
+    if(samples.empty())
+        return;
+    std::sort(samples.begin(), samples.end());
+
+    // Tukey's fences.
+    if(benchmark_options.outlier_fence > 0.0 && samples.size() >= 4) {
+        const auto q1 = quantile(samples, 0.25);
+        const auto q3 = quantile(samples, 0.75);
+        const auto fence = benchmark_options.outlier_fence * (q3 - q1);
+        const auto first = std::lower_bound(samples.begin(), samples.end(),
+                                            q1 - fence);
+        const auto last = std::upper_bound(first, samples.end(), q3 + fence);
+        result.outliers = samples.size() -
+                          static_cast<std::size_t>(last - first);
+        samples = std::vector<double>(first, last);
+    }
+
+    const auto n = samples.size();
+    result.samples = n;
+    result.min = samples.front();
+    result.max = samples.back();
+    result.median = quantile(samples, 0.5);
+
+    double sum = 0.0;
+    for(const auto sample : samples)
+        sum += sample;
+    result.mean = sum / static_cast<double>(n);
+    double squares = 0.0;
+    for(const auto sample : samples)
+        squares += (sample - result.mean) * (sample - result.mean);
+    result.stddev = n < 2? 0.0 :
+                    std::sqrt(squares / static_cast<double>(n - 1));
+
+    // The number of samples below the median is Binomial(n, 1/2), so the
+    // order statistics at n/2 -+ z sqrt(n)/2 bound the median with the
+    // given confidence, whatever the distribution of the samples.
+    const auto half_width = normalQuantile(benchmark_options.confidence) *
+                            std::sqrt(static_cast<double>(n)) / 2.0;
+    const auto low = std::floor(static_cast<double>(n) / 2.0 - half_width);
+    const auto high = std::ceil(static_cast<double>(n) / 2.0 + half_width);
+    result.ci_low = samples[static_cast<std::size_t>(std::max(low, 1.0)) - 1];
+    result.ci_high = samples[static_cast<std::size_t>(
+        std::min(high, static_cast<double>(n))) - 1];
+}
+
+inline double BenchmarkRunner::quantile(const std::vector<double>& values,
+                                        double fraction) noexcept {
+    const auto position = fraction * static_cast<double>(values.size() - 1);
+    const auto below = static_cast<std::size_t>(position);
+    const auto above = std::min(below + 1, values.size() - 1);
+    const auto weight = position - static_cast<double>(below);
+    return values[below] * (1.0 - weight) + values[above] * weight;
+}
+
+inline double BenchmarkRunner::normalQuantile(double confidence) noexcept {
+    confidence = std::clamp(confidence, 0.0, 0.999999);
+    // Bisect erf(z / sqrt(2)) = confidence; it is increasing in z.
+    double low = 0.0;
+    double high = 10.0;
+    for(int step = 0; step < 60; ++step) {
+        const auto middle = (low + high) / 2.0;
+        if(std::erf(middle / std::sqrt(2.0)) < confidence)
+            low = middle;
+        else
+            high = middle;
+    }
+    return (low + high) / 2.0;
+}
+
+//---------------------------------[ Output ]---------------------------------//
+
+inline std::string BenchmarkRunner::formatTime(double nanoseconds) {
+    static constexpr std::pair<double, const char*> units[] {
+        {1e9, "s"}, {1e6, "ms"}, {1e3, "us"}
+    };
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(3);
+    for(const auto& [scale, unit] : units) {
+        if(nanoseconds >= scale) {
+            text << nanoseconds / scale << ' ' << unit;
+            return text.str();
+        }
+    }
+    text << nanoseconds << " ns";
+    return text.str();
+}
+
+inline void BenchmarkRunner::print(std::ostream& output) const {
+    std::size_t name_width = 9;
+    for(const auto& result : benchmark_results)
+        name_width = std::max(name_width, result.name.size());
+
+    output
+    << std::left << std::setw(static_cast<int>(name_width)) << "benchmark"
+    << std::right
+    << std::setw(13) << "median"
+    << "  " << std::setw(3)
+    << static_cast<int>(std::lround(benchmark_options.confidence * 100))
+    << "% CI of the median" << '\n';
+
+    for(const auto& result : benchmark_results) {
+        output << std::left << std::setw(static_cast<int>(name_width))
+               << result.name << std::right;
+        if(result.samples == 0) {
+            output << "  (skipped)\n";
+            continue;
+        }
+        output
+        << std::setw(13) << formatTime(result.median)
+        << "  [" << formatTime(result.ci_low)
+        << ", " << formatTime(result.ci_high) << "]"
+        << "  " << result.samples << " x " << result.iterations;
+        if(result.outliers > 0)
+            output << "  " << result.outliers << " outliers";
+        if(!result.complete)
+            output << "  (stopped)";
+        output << '\n';
+    }
+}
+
+inline void BenchmarkRunner::writeJsonString(std::ostream& output,
+                                             const std::string& text) {
+    output << '"';
+    for(const auto character : text) {
+        const auto c = static_cast<unsigned char>(character);
+        if(c == '"' || c == '\\')
+            output << '\\' << character;
+        else if(c < 0x20)
+            output << "\\u00" << "0123456789abcdef"[c >> 4]
+                   << "0123456789abcdef"[c & 0xF];
+        else
+            output << character;
+    }
+    output << '"';
+}
+
+inline void BenchmarkRunner::writeJson(std::ostream& output) const {
+    output
+    << std::fixed << std::setprecision(3)
+    << "{\"confidence\":" << benchmark_options.confidence
+    << ",\"benchmarks\":[";
+    bool first = true;
+    for(const auto& result : benchmark_results) {
+        output << (first? "\n" : ",\n") << "{\"name\":";
+        first = false;
+        writeJsonString(output, result.name);
+        output
+        << ",\"iterations\":" << result.iterations
+        << ",\"samples\":" << result.samples
+        << ",\"outliers\":" << result.outliers
+        << ",\"median_ns\":" << result.median
+        << ",\"ci_low_ns\":" << result.ci_low
+        << ",\"ci_high_ns\":" << result.ci_high
+        << ",\"mean_ns\":" << result.mean
+        << ",\"stddev_ns\":" << result.stddev
+        << ",\"min_ns\":" << result.min
+        << ",\"max_ns\":" << result.max
+        << ",\"complete\":" << (result.complete? "true" : "false")
+        << '}';
+    }
+    output << "\n]}\n";
+}
+
+inline void BenchmarkRunner::writeCsv(std::ostream& output) const {
+    output
+    << std::fixed << std::setprecision(3)
+    << "name,iterations,samples,outliers,median_ns,ci_low_ns,ci_high_ns,"
+       "mean_ns,stddev_ns,min_ns,max_ns,complete\n";
+    for(const auto& result : benchmark_results) {
+        // Names are always quoted, with inner quotes doubled.
+        output << '"';
+        for(const auto character : result.name)
+            output << (character == '"'? "\"\"" : std::string(1, character));
+        output
+        << "\"," << result.iterations
+        << ',' << result.samples
+        << ',' << result.outliers
+        << ',' << result.median
+        << ',' << result.ci_low
+        << ',' << result.ci_high
+        << ',' << result.mean
+        << ',' << result.stddev
+        << ',' << result.min
+        << ',' << result.max
+        << ',' << (result.complete? 1 : 0)
+        << '\n';
+    }
+}
+
+inline bool BenchmarkRunner::readCsv(std::istream& input,
+                                     std::vector<BenchmarkResult>& results) {
+    std::string line;
+    if(!std::getline(input, line) || line.rfind("name,", 0) != 0)
+        return false;
+
+    std::vector<BenchmarkResult> loaded;
+    while(std::getline(input, line)) {
+        if(line.empty())
+            continue;
+        if(line.front() != '"')
+            return false;
+
+        BenchmarkResult result;
+        std::size_t position = 1;
+        while(true) {
+            const auto quote = line.find('"', position);
+            if(quote == std::string::npos)
+                return false;
+            result.name.append(line, position, quote - position);
+            if(quote + 1 < line.size() && line[quote + 1] == '"') {
+                result.name += '"';
+                position = quote + 2;
+                continue;
+            }
+            position = quote + 1;
+            break;
+        }
+
+        std::istringstream fields(line.substr(position));
+        char comma = 0;
+        int complete = 0;
+        fields
+        >> comma >> result.iterations >> comma >> result.samples
+        >> comma >> result.outliers >> comma >> result.median
+        >> comma >> result.ci_low >> comma >> result.ci_high
+        >> comma >> result.mean >> comma >> result.stddev
+        >> comma >> result.min >> comma >> result.max
+        >> comma >> complete;
+        if(!fields || comma != ',')
+            return false;
+        result.complete = complete != 0;
+        loaded.push_back(std::move(result));
+    }
+    results = std::move(loaded);
+    return true;
+}
+
+inline std::size_t BenchmarkRunner::compare(
+        const std::vector<BenchmarkResult>& baseline,
+        std::ostream& output, double tolerance) const {
+    std::map<std::string, const BenchmarkResult*> by_name;
+    for(const auto& result : baseline)
+        by_name.emplace(result.name, &result);
+
+    std::size_t name_width = 9;
+    for(const auto& result : benchmark_results)
+        name_width = std::max(name_width, result.name.size());
+
+    output
+    << std::left << std::setw(static_cast<int>(name_width)) << "benchmark"
+    << std::right
+    << std::setw(13) << "baseline"
+    << std::setw(13) << "current"
+    << std::setw(9) << "ratio" << '\n';
+
+    std::size_t slower = 0;
+    for(const auto& result : benchmark_results) {
+        const auto found = by_name.find(result.name);
+        if(found == by_name.end() || result.samples == 0 ||
+           found->second->samples == 0)
+            continue;
+        const auto& before = *found->second;
+        const auto ratio = before.median > 0.0?
+                           result.median / before.median : 1.0;
+
+        // Flag only changes beyond the tolerance whose intervals are apart.
+        const char* verdict = "";
+        if(ratio > 1.0 + tolerance && result.ci_low > before.ci_high) {
+            verdict = "  slower";
+            ++slower;
+        }
+        else if(ratio < 1.0 - tolerance && result.ci_high < before.ci_low) {
+            verdict = "  faster";
+        }
+
+        output
+        << std::left << std::setw(static_cast<int>(name_width))
+        << result.name << std::right
+        << std::setw(13) << formatTime(before.median)
+        << std::setw(13) << formatTime(result.median)
+        << std::fixed << std::setprecision(3)
+        << std::setw(9) << ratio << verdict << '\n';
+    }
+    return slower;
+}
+
+} // end of namespace cea
@@ -0,0 +1,282 @@
+/******************************************************************************
+ * @file clock_calibration.hpp
+ * @brief Interface for the ClockCalibration and BasicCalibratedTimer classes.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/timer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace cea {
+
+/**
+ * \brief ClockCalibration class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * The resolution and overheads of a clock policy, measured on this machine:
+ *
+ * \code
+ *     const auto& calibration = cea::ClockCalibration::of<>();
+ *     calibration.print(std::cout);
+ *     // resolution: 1ns, read overhead: 19ns, timer bias: 21ns
+ * \endcode
+ *
+ * The calibration of each clock is measured once, on the first call of
+ * of<Clock>(), in about a millisecond (up to a few kernel ticks for coarse
+ * clocks). Call it at startup to keep that out of the measurements.
+ *
+ * The timer bias is what an empty region measures: the time from the clock
+ * read in `start()` or `resume()` to the one in `stop()`. It is subtracted
+ * once per region by BasicCalibratedTimer.
+ */
+struct ClockCalibration {
+    /// The smallest step the clock was seen to advance, or zero if unknown:
+    /// the clock did not advance during the calibration (e.g., a frozen
+    /// VirtualClock).
+    std::chrono::nanoseconds resolution {0};
+
+    /// The median cost of reading the clock.
+    std::chrono::nanoseconds read_overhead {0};
+
+    /// The median time measured by `start()` and `stop()` around nothing.
+    std::chrono::nanoseconds timer_bias {0};
+
+    /// Return the calibration of `Clock`, measuring it on the first call.
+    template <class Clock = steady_clock>
+    static const ClockCalibration& of() {
+        static const auto calibration = measure<Clock>();
+        return calibration;
+    }
+
+    /// Measure the calibration of `Clock` now.
+    template <class Clock = steady_clock>
+    static ClockCalibration measure();
+
+    /// Print the calibration in a single line.
+    void print(std::ostream& output) const {
+        output << "resolution: ";
+        if(resolution > std::chrono::nanoseconds {0})
+            output << resolution;
+        else
+            output << "unknown";
+        output
+        << ", read overhead: " << read_overhead
+        << ", timer bias: " << timer_bias
+        << '\n';
+    }
+
+protected:
+    /// Return the median of `values`, reordering them.
+    template <std::size_t Size>
+    static std::chrono::nanoseconds median(
+        std::array<std::chrono::nanoseconds, Size>& values) noexcept {
+        std::nth_element(values.begin(), values.begin() + Size / 2,
+                         values.end());
+        return values[Size / 2];
+    }
+};
+
+/**
+ * \brief BasicCalibratedTimer class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A BasicTimer that subtracts the timer bias of its clock from each region
+ * between starts and stops, so sub-microsecond regions are not inflated by
+ * the clock reads around them:
+ *
+ * \code
+ *     cea::CalibratedTimer timer;
+ *     timer.start();
+ *     lookup(key);
+ *     timer.stop();
+ *     timer.print(std::cout);
+ *     // 37ns (raw 58ns)
+ * \endcode
+ *
+ * The result is clamped at zero. When the raw measurement is below the
+ * resolution of the clock (once per region), isBelowResolution() tells so
+ * and print() warns about it: the measurement is mostly quantization, and the
+ * region should be repeated inside the timed one, or timed with a finer
+ * clock.
+ *
+ * \tparam Clock the clock policy used to read the current time.
+ */
+template <class Clock = steady_clock>
+class BasicCalibratedTimer {
+public:
+    /// The clock policy used by this timer.
+    using clock = Clock;
+
+    /** \name Constructor */
+    //@{
+    /// Build a timer, calibrating the clock if not done yet.
+    BasicCalibratedTimer():
+        calibration {ClockCalibration::of<Clock>()},
+        timer {},
+        num_regions {0}
+    {}
+    //@}
+
+    /** Timer manipulation */
+    //@{
+    /// Start the timer. It also works as a reset.
+    void start() noexcept {
+        num_regions = 1;
+        timer.start();
+    }
+
+    /// Stop the timer.
+    void stop() noexcept {
+        timer.stop();
+    }
+
+    /// Resume the timer.
+    void resume() noexcept {
+        if(!timer.isStopped())
+            return;
+        ++num_regions;
+        timer.resume();
+    }
+    //@}
+
+    /** Time retrieval */
+    //@{
+    /// Return the elapsed time between starts and stops, minus the timer
+    /// bias of each region, in nanoseconds.
+    std::chrono::nanoseconds elapsedInNanoseconds() const noexcept {
+        return std::max(timer.elapsedInNanoseconds() -
+                        num_regions * calibration.timer_bias,
+                        std::chrono::nanoseconds {0});
+    }
+
+    /// Return the elapsed time between starts and stops in seconds.
+    std::chrono::seconds elapsed() const noexcept {
+        return duration_cast<seconds>(elapsedInNanoseconds());
+    }
+
+    /// Return the elapsed time as measured by the clock, without
+    /// subtracting the bias.
+    std::chrono::nanoseconds rawElapsedInNanoseconds() const noexcept {
+        return timer.elapsedInNanoseconds();
+    }
+
+    /// Return true if the raw elapsed time is below the clock resolution
+    /// per region, so the measurement is mostly quantization.
+    bool isBelowResolution() const noexcept {
+        return timer.elapsedInNanoseconds() <
+               num_regions * calibration.resolution;
+    }
+
+    /// Return true if the timer has been stopped.
+    bool isStopped() const noexcept {
+        return timer.isStopped();
+    }
+
+    /// Return the calibration used by this timer.
+    const ClockCalibration& clockCalibration() const noexcept {
+        return calibration;
+    }
+
+    /// Print the elapsed time, the raw one, and a warning if it is below
+    /// the clock resolution.
+    void print(std::ostream& output) const {
+        output << elapsedInNanoseconds()
+               << " (raw " << rawElapsedInNanoseconds();
+        if(isBelowResolution())
+            output << ", below the clock resolution of "
+                   << calibration.resolution;
+        output << ")\n";
+    }
+    //@}
+
+protected:
+    /** \name Data members */
+    //@{
+    /// The calibration of the clock.
+    ClockCalibration calibration;
+
+    /// Measures the raw time.
+    BasicTimer<Clock> timer;
+
+    /// Regions between starts/resumes and stops since the last start.
+    std::int64_t num_regions;
+    //@}
+};
+
+/// The default calibrated timer, based on `std::chrono::steady_clock`.
+using CalibratedTimer = BasicCalibratedTimer<steady_clock>;
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+template <class Clock>
+ClockCalibration ClockCalibration::measure() {
+    ClockCalibration calibration;
+
+    // The first read may set the clock up (e.g., calibrate the TSC).
+    (void) Clock::now();
+
+    // Resolution: the smallest step between reads that differ. Coarse clocks
+    // need a kernel tick per step, so only a few steps are taken. A clock
+    // that does not advance in `max_wait` has an unknown resolution.
+    static constexpr auto max_wait = std::chrono::milliseconds {200};
+    const auto give_up = steady_clock::now() + max_wait;
+    auto resolution = std::chrono::nanoseconds::max();
+    for(int step = 0; step < 8; ++step) {
+        const auto before = Clock::now();
+        auto after = Clock::now();
+        for(unsigned spins = 1; after == before; ++spins) {
+            if(spins % 1024 == 0 && steady_clock::now() > give_up)
+                break;
+            after = Clock::now();
+        }
+        if(after == before)
+            break;
+        resolution = std::min(resolution,
+                              duration_cast<nanoseconds>(after - before));
+    }
+    calibration.resolution = resolution == std::chrono::nanoseconds::max()?
+                             std::chrono::nanoseconds {0} : resolution;
+
+    // Read overhead: the median of batches of back-to-back reads.
+    static constexpr int batch_size = 64;
+    std::array<std::chrono::nanoseconds, 31> batches {};
+    for(auto& batch : batches) {
+        const auto before = steady_clock::now();
+        for(int read = 0; read < batch_size; ++read)
+            (void) Clock::now();
+        batch = (steady_clock::now() - before) / batch_size;
+    }
+    calibration.read_overhead = median(batches);
+
+    // Timer bias: the median time of empty regions.
+    std::array<std::chrono::nanoseconds, 1001> regions {};
+    BasicTimer<Clock> timer;
+    for(auto& region : regions) {
+        timer.start();
+        timer.stop();
+        region = timer.elapsedInNanoseconds();
+    }
+    calibration.timer_bias = median(regions);
+    return calibration;
+}
+
+} // end of namespace cea
@@ -0,0 +1,201 @@
+/******************************************************************************
+ * @file concurrent_timer.hpp
+ * @brief Interface for the BasicConcurrentTimer class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace cea {
+
+/**
+ * \brief BasicConcurrentTimer class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A BasicTimer that can be read from any number of threads while a single
+ * controller thread starts, stops, and resumes it.
+ *
+ * The state is protected by a seqlock: the controller bumps a sequence
+ * counter to an odd value, reads the clock and updates the fields, and bumps
+ * it back to even. Readers never block nor write shared memory; they read
+ * the fields (and the clock) between two loads of the counter, and retry only
+ * if a write happened in between, which takes a few nanoseconds on every
+ * start/stop/resume. So reads scale with the number of reader threads.
+ * All fields are atomics, so there is no data race in the C++ memory model
+ * (and nothing for ThreadSanitizer to flag).
+ *
+ * The controls themselves are not synchronized with each other: only one
+ * thread may call start(), stop(), and resume() at a time.
+ *
+ * \tparam Clock the clock policy used to read the current time (see
+ *         BasicTimer). Its `rep` must be an integral type.
+ */
+template <class Clock = std::chrono::steady_clock>
+class BasicConcurrentTimer {
+public:
+    /// The clock policy used by this timer.
+    using clock = Clock;
+
+    /** \name Constructor and destructor */
+    //@{
+    /// Default Constructor.
+    BasicConcurrentTimer():
+        sequence {0},
+        start_ticks {0},
+        time_duration {0},
+        is_stopped {true}
+    {}
+
+    BasicConcurrentTimer(const BasicConcurrentTimer&) = delete;
+    BasicConcurrentTimer& operator=(const BasicConcurrentTimer&) = delete;
+    //@}
+
+    /** Timer manipulation (controller thread only) */
+    //@{
+    /// Start the timer. It also works as a reset.
+    void start() noexcept {
+        beginWrite();
+        const auto now = ticks(Clock::now());
+        is_stopped.store(false, std::memory_order_relaxed);
+        time_duration.store(0, std::memory_order_relaxed);
+        start_ticks.store(now, std::memory_order_relaxed);
+        endWrite();
+    }
+
+    /// Stop the timer.
+    void stop() noexcept {
+        if(is_stopped.load(std::memory_order_relaxed))
+            return;
+        beginWrite();
+        const auto now = ticks(Clock::now());
+        time_duration.store(time_duration.load(std::memory_order_relaxed) +
+                            elapsedTicks(now), std::memory_order_relaxed);
+        is_stopped.store(true, std::memory_order_relaxed);
+        endWrite();
+    }
+
+    /// Resume the timer.
+    void resume() noexcept {
+        if(!is_stopped.load(std::memory_order_relaxed))
+            return;
+        beginWrite();
+        const auto now = ticks(Clock::now());
+        start_ticks.store(now, std::memory_order_relaxed);
+        is_stopped.store(false, std::memory_order_relaxed);
+        endWrite();
+    }
+    //@}
+
+    /** Time retrieval (any thread) */
+    //@{
+    /// Return the elapsed time between starts and stops in nanoseconds.
+    std::chrono::nanoseconds elapsedInNanoseconds() const noexcept {
+        return read([] { return Clock::now(); });
+    }
+
+    /**
+     * \brief Return the elapsed time in nanoseconds, as of the given time.
+     * \param now the current time, possibly approximated (e.g., a coarse
+     *        timestamp). If it is before the last start or resume, the time
+     *        since then is taken as zero.
+     */
+    std::chrono::nanoseconds elapsedInNanosecondsAt(
+        typename Clock::time_point now) const noexcept {
+        return read([now] { return now; });
+    }
+
+    /// Return the elapsed time between starts and stops in seconds.
+    std::chrono::seconds elapsed() const noexcept {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+            elapsedInNanoseconds());
+    }
+
+    /// Return true if the timer has been stopped.
+    bool isStopped() const noexcept {
+        return is_stopped.load(std::memory_order_acquire);
+    }
+    //@}
+
+protected:
+    /** \name Seqlock helpers */
+    //@{
+    /// Read the elapsed time, getting the current time from `current_time`.
+    template <class CurrentTime>
+    std::chrono::nanoseconds read(CurrentTime current_time) const noexcept {
+        typename Clock::rep duration;
+        for(;;) {
+            const auto begin = sequence.load(std::memory_order_acquire);
+            duration = time_duration.load(std::memory_order_relaxed);
+            // The clock is read inside the critical section too, so that a
+            // concurrent stop() cannot make the elapsed time go backwards.
+            if(!is_stopped.load(std::memory_order_relaxed)) {
+                const auto running = ticks(current_time()) -
+                    start_ticks.load(std::memory_order_relaxed);
+                if(running > 0)
+                    duration += running;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // Odd: a write was in progress. Changed: a write happened.
+            if((begin & 1) == 0 &&
+               sequence.load(std::memory_order_relaxed) == begin)
+                break;
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            typename Clock::duration {duration});
+    }
+
+    /// Convert a time point to clock ticks.
+    static typename Clock::rep ticks(typename Clock::time_point time) noexcept {
+        return time.time_since_epoch().count();
+    }
+
+    /// Return the ticks elapsed since the last start or resume.
+    typename Clock::rep elapsedTicks(typename Clock::rep now) const noexcept {
+        return now - start_ticks.load(std::memory_order_relaxed);
+    }
+
+    /// Make the sequence odd, so readers retry.
+    void beginWrite() noexcept {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /// Make the sequence even again, publishing the new values.
+    void endWrite() noexcept {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+    }
+    //@}
+
+    /** \name Data members */
+    //@{
+    /// Odd while the controller is writing.
+    std::atomic<std::uint64_t> sequence;
+
+    /// Clock ticks at the last start or resume.
+    std::atomic<typename Clock::rep> start_ticks;
+
+    /// Clock ticks accumulated between starts and stops.
+    std::atomic<typename Clock::rep> time_duration;
+
+    /// Indicates whether the timer is stopped or not.
+    std::atomic<bool> is_stopped;
+    //@}
+};
+
+/// The default concurrent timer, based on `std::chrono::steady_clock`.
+using ConcurrentTimer = BasicConcurrentTimer<std::chrono::steady_clock>;
+
+} // end of namespace cea
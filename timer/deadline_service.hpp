@@ -0,0 +1,422 @@
+/******************************************************************************
+ * @file deadline_service.hpp
+ * @brief Interface for the DeadlineService class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/timing_wheel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace cea {
+
+/**
+ * \brief DeadlineNode class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Base class for anything scheduled in the DeadlineService. The service calls
+ * `onDeadline()` from its own thread when the node's deadline is reached.
+ * The owner must cancel the node before destroying it. Nodes are intrusive,
+ * so scheduling never allocates.
+ */
+class DeadlineNode: private TimingWheelNode {
+public:
+    /** \name Constructor and destructor */
+    //@{
+    DeadlineNode() = default;
+    DeadlineNode(const DeadlineNode&) = delete;
+    DeadlineNode& operator=(const DeadlineNode&) = delete;
+    virtual ~DeadlineNode() = default;
+    //@}
+
+    /// Called by the service thread when the deadline is reached.
+    virtual void onDeadline() noexcept = 0;
+
+private:
+    friend class DeadlineService;
+};
+
+/**
+ * \brief DeadlineService class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * This class is a singleton holding a single, long-lived service thread that
+ * serves the deadlines of any number of DeadlineNodes. The deadlines are kept
+ * in a hierarchical TimingWheel with `tick` resolution, so scheduling and
+ * cancelling are O(1) regardless of how many deadlines are active. The
+ * thread sleeps until the next tick with work to do, and only wakes up
+ * earlier when a node is scheduled before it. Deadlines are rounded up to
+ * the next tick, so nodes never fire early.
+ *
+ * The callbacks run without holding the service lock, so they can schedule
+ * again. `cancel()` waits for a callback running in another thread to finish,
+ * so the owner can safely destroy the node afterwards.
+ *
+ * Deadlines are given in steady clock nanoseconds since its epoch (see
+ * `now()`).
+ *
+ * The service also publishes a coarse timestamp (see `coarseNow()`), so hot
+ * loops can read an approximate time with a single atomic load instead of a
+ * clock read. The publisher only runs after the first `coarseNow()` call, so
+ * programs that never use it do not pay for the periodic wake-ups.
+ *
+ * For tests, the service time can be switched to virtual time (see
+ * VirtualClock): `now()` then stands still until advanceVirtualTime() moves
+ * it, and the service thread only fires the deadlines that virtual time
+ * reached, before advanceVirtualTime() returns.
+ */
+class DeadlineService {
+public:
+    /// Deadline value meaning "no deadline".
+    static constexpr std::int64_t no_deadline =
+        std::numeric_limits<std::int64_t>::max();
+
+    /// Resolution of the deadlines, in nanoseconds.
+    static constexpr std::int64_t tick = 100'000;
+
+    /// Period of the coarse timestamp updates, in nanoseconds.
+    static constexpr std::int64_t coarse_period = 1'000'000;
+
+    /// Get a reference for the instance, starting the service thread.
+    static DeadlineService& instance();
+
+    /// Return the current steady clock time in nanoseconds since its epoch,
+    /// or the virtual time, if enabled.
+    static std::int64_t now() noexcept;
+
+    /**
+     * \brief Return the steady clock time published by the service thread.
+     *
+     * It is a single relaxed atomic load, updated every `coarse_period` (plus
+     * the scheduling latency), so it lags `now()` by about a millisecond.
+     * The first call starts the updates and returns `now()`.
+     */
+    static std::int64_t coarseNow() noexcept;
+
+    /**
+     * \brief Schedule a node.
+     * \param node the node to be scheduled.
+     * \param deadline the deadline in steady clock nanoseconds.
+     *
+     * If the node is already scheduled earlier, the earlier deadline is kept.
+     * Firing early is harmless: the callback is expected to check its own
+     * deadline and schedule again if needed.
+     */
+    void schedule(DeadlineNode& node, std::int64_t deadline) noexcept;
+
+    /**
+     * \brief Remove a node from the service.
+     *
+     * If the node's callback is running in another thread, wait for it to
+     * finish, and then remove the node, even if the callback scheduled it
+     * again. Calling it from the callback itself does not wait.
+     */
+    void cancel(DeadlineNode& node) noexcept;
+
+    /** Virtual time */
+    //@{
+    /// Return true if the service runs on virtual time.
+    static bool isVirtualTime() noexcept {
+        return virtual_now.load(std::memory_order_relaxed) != 0;
+    }
+
+    /**
+     * \brief Freeze the service time, and move it only on
+     *        advanceVirtualTime().
+     *
+     * The virtual time starts at the current time, rounded up to a `tick`,
+     * so deadlines that are whole multiples of `tick` away fire exactly when
+     * virtual time reaches them.
+     */
+    void enableVirtualTime() noexcept;
+
+    /// Go back to the steady clock, continuing from the virtual time.
+    void disableVirtualTime() noexcept;
+
+    /**
+     * \brief Move the virtual time forward, and wait for the service thread
+     *        to fire all deadlines up to the new time.
+     *
+     * Does nothing if virtual time is not enabled. Must not be called from a
+     * deadline callback.
+     */
+    void advanceVirtualTime(std::int64_t delta) noexcept;
+    //@}
+
+private:
+    /** \name Private methods to avoid creation and copy */
+    //@{
+    DeadlineService();
+    DeadlineService(const DeadlineService&) = delete;
+    ~DeadlineService();
+    DeadlineService& operator=(const DeadlineService&) = delete;
+    //@}
+
+    /// Body of the service thread.
+    void run() noexcept;
+
+    /// Start publishing the coarse timestamp, and return now().
+    std::int64_t startCoarseUpdates() noexcept;
+
+    /// Publishes the coarse timestamp every `coarse_period`.
+    struct CoarseTicker: DeadlineNode {
+        void onDeadline() noexcept override;
+    };
+
+    /// Convert a deadline to a wheel tick, rounding up.
+    static std::int64_t toTick(std::int64_t deadline) noexcept {
+        if(deadline > no_deadline - tick)
+            return no_deadline / tick;
+        return (deadline + tick - 1) / tick;
+    }
+
+    /** \name Data members */
+    //@{
+    /// Coarse steady clock time, or 0 before the first coarseNow() call.
+    static inline std::atomic<std::int64_t> coarse_now {0};
+
+    /// The virtual time, or 0 when running on the steady clock.
+    static inline std::atomic<std::int64_t> virtual_now {0};
+
+    /// Added to the steady clock, so the time goes on from the virtual time
+    /// once it is disabled.
+    static inline std::atomic<std::int64_t> steady_offset {0};
+
+    /// Mutex guarding the wheel.
+    std::mutex mutex;
+
+    /// Wakes the service thread up when the earliest deadline changes.
+    std::condition_variable wakeup_cv;
+
+    /// Notified when a callback finishes.
+    std::condition_variable fired_cv;
+
+    /// Scheduled nodes.
+    TimingWheel wheel;
+
+    /// Tick at which the service thread wakes up; minimum while awake.
+    std::int64_t wakeup_tick;
+
+    /// Node whose callback is running, if any.
+    DeadlineNode* firing;
+
+    /// Time up to which all deadlines were fired, as the service thread last
+    /// went to sleep.
+    std::int64_t idle_time;
+
+    /// Asks the service thread to finish.
+    bool shutdown;
+
+    /// Publisher of the coarse timestamp.
+    CoarseTicker coarse_ticker;
+
+    /// Indicates whether coarse_ticker was scheduled.
+    std::atomic<bool> coarse_started;
+
+    /// The service thread.
+    std::thread service_thread;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//------------------[ Default Constructor and Destructor ]--------------------//
+
+inline DeadlineService::DeadlineService():
+    mutex {},
+    wakeup_cv {},
+    fired_cv {},
+    wheel {now() / tick},
+    wakeup_tick {std::numeric_limits<std::int64_t>::min()},
+    firing {nullptr},
+    idle_time {std::numeric_limits<std::int64_t>::min()},
+    shutdown {false},
+    coarse_ticker {},
+    coarse_started {false},
+    service_thread {}
+{
+    service_thread = std::thread {[this] { run(); }};
+}
+
+inline DeadlineService::~DeadlineService() {
+    {
+        std::lock_guard lock(mutex);
+        shutdown = true;
+    }
+    wakeup_cv.notify_all();
+    if(service_thread.joinable())
+        service_thread.join();
+    wheel.remove(coarse_ticker);
+}
+
+//--------------------[ Singleton instance initialization ]-------------------//
+
+inline DeadlineService& DeadlineService::instance() {
+    static DeadlineService inst;
+    return inst;
+}
+
+//-----------------------------[ Scheduling ]---------------------------------//
+
+inline std::int64_t DeadlineService::now() noexcept {
+    const auto virtual_time = virtual_now.load(std::memory_order_relaxed);
+    if(virtual_time != 0) [[unlikely]]
+        return virtual_time;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count() +
+        steady_offset.load(std::memory_order_relaxed);
+}
+
+inline std::int64_t DeadlineService::coarseNow() noexcept {
+    const auto coarse = coarse_now.load(std::memory_order_relaxed);
+    if(coarse != 0) [[likely]]
+        return coarse;
+    return instance().startCoarseUpdates();
+}
+
+inline std::int64_t DeadlineService::startCoarseUpdates() noexcept {
+    const auto current = now();
+    if(!coarse_started.exchange(true)) {
+        coarse_now.store(current, std::memory_order_relaxed);
+        schedule(coarse_ticker, current + coarse_period);
+    }
+    return current;
+}
+
+inline void DeadlineService::CoarseTicker::onDeadline() noexcept {
+    const auto current = now();
+    coarse_now.store(current, std::memory_order_relaxed);
+    instance().schedule(*this, current + coarse_period);
+}
+
+inline void DeadlineService::schedule(DeadlineNode& node,
+                                      std::int64_t deadline) noexcept {
+    const auto deadline_tick = toTick(deadline);
+    bool wake_up;
+    {
+        std::lock_guard lock(mutex);
+        if(node.isLinked()) {
+            if(node.expiryTick() <= deadline_tick)
+                return;
+            wheel.remove(node);
+        }
+        wheel.insert(node, deadline_tick);
+        wake_up = deadline_tick < wakeup_tick;
+    }
+    if(wake_up)
+        wakeup_cv.notify_one();
+}
+
+inline void DeadlineService::cancel(DeadlineNode& node) noexcept {
+    std::unique_lock lock(mutex);
+    // Wait first: a running callback may schedule the node again.
+    if(std::this_thread::get_id() != service_thread.get_id())
+        fired_cv.wait(lock, [&] { return firing != &node; });
+    wheel.remove(node);
+}
+
+//-----------------------------[ Virtual time ]-------------------------------//
+
+inline void DeadlineService::enableVirtualTime() noexcept {
+    {
+        std::lock_guard lock(mutex);
+        if(isVirtualTime())
+            return;
+        const auto current = (now() / tick + 1) * tick;
+        virtual_now.store(current, std::memory_order_relaxed);
+        if(coarse_started.load(std::memory_order_relaxed))
+            coarse_now.store(current, std::memory_order_relaxed);
+    }
+    // Replace the timed wait of the service thread by an untimed one.
+    wakeup_cv.notify_one();
+}
+
+inline void DeadlineService::disableVirtualTime() noexcept {
+    {
+        std::lock_guard lock(mutex);
+        const auto virtual_time = virtual_now.load(std::memory_order_relaxed);
+        if(virtual_time == 0)
+            return;
+        steady_offset.store(virtual_time -
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count(),
+            std::memory_order_relaxed);
+        virtual_now.store(0, std::memory_order_relaxed);
+    }
+    wakeup_cv.notify_one();
+}
+
+inline void DeadlineService::advanceVirtualTime(std::int64_t delta) noexcept {
+    std::unique_lock lock(mutex);
+    const auto virtual_time = virtual_now.load(std::memory_order_relaxed);
+    if(virtual_time == 0)
+        return;
+    const auto target = virtual_time + std::max(delta, std::int64_t {0});
+    virtual_now.store(target, std::memory_order_relaxed);
+    wakeup_cv.notify_one();
+    fired_cv.wait(lock, [&] { return idle_time >= target || shutdown; });
+}
+
+//---------------------------[ Service thread ]-------------------------------//
+
+inline void DeadlineService::run() noexcept {
+    std::unique_lock lock(mutex);
+    while(!shutdown) {
+        const auto current = now();
+        wheel.advance(current / tick);
+
+        // Fire the callbacks one by one, without holding the lock.
+        if(auto* expired = wheel.popExpired()) {
+            auto* node = static_cast<DeadlineNode*>(expired);
+            firing = node;
+            lock.unlock();
+            node->onDeadline();
+            lock.lock();
+            firing = nullptr;
+            fired_cv.notify_all();
+            continue;
+        }
+
+        // Everything due was fired; let advanceVirtualTime() return.
+        idle_time = current;
+        fired_cv.notify_all();
+
+        // On virtual time, only advanceVirtualTime() and schedule() wake the
+        // thread up.
+        const auto next = wheel.nextEventTick();
+        wakeup_tick = next;
+        if(next == TimingWheel::no_tick || isVirtualTime())
+            wakeup_cv.wait(lock);
+        else
+            wakeup_cv.wait_until(lock,
+                std::chrono::steady_clock::time_point {
+                    std::chrono::duration_cast<
+                        std::chrono::steady_clock::duration>(
+                            std::chrono::nanoseconds {next * tick -
+                                steady_offset.load(
+                                    std::memory_order_relaxed)})});
+        wakeup_tick = std::numeric_limits<std::int64_t>::min();
+    }
+}
+
+} // end of namespace cea
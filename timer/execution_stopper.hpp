@@ -6,21 +6,32 @@
  * SPDX-License-Identifier: BSD-3-Clause.
  *
  * Created on : 2015-06-17 by ceandrade.
- * Last update: 2026-07-26 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
  ******************************************************************************/
 
 #pragma once
 
-#include "timer/timer.hpp"
+#include "timer/notification_fd.hpp"
+#include "timer/stop_scope.hpp"
+#include "timer/tracer.hpp"
 
+#if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    #include <poll.h>
+    #include <signal.h>
+#endif
+
+#include <algorithm>
 #include <atomic>
+#include <cerrno>
 #include <chrono>
-#include <condition_variable>
 #include <csignal>
+#include <cstdint>
 #include <iostream>
-#include <limits>
 #include <mutex>
+#include <optional>
+#include <stop_token>
 #include <thread>
+#include <vector>
 
 namespace cea {
 
@@ -34,12 +45,33 @@ namespace cea {
  * either elapsed time or user intervention. It features a timer that can be
  * controlled through external calls. Additionally, it overrides
  * the Ctrl-C signal handling to enable a smoother termination of the
- * algorithm.
+ * algorithm. Other signals, such as SIGTERM sent by container runtimes, can
+ * be handled as well (see handleSignal()).
+ *
+ * On POSIX systems, the signal handler installed by `sigaction()` only
+ * records the signal in an atomic and writes to a NotificationFd, both
+ * async-signal-safe. A dedicated signal thread wakes up on it, expires the
+ * stopper, restores the previous handler, and prints the message, so a
+ * signal landing in the middle of a log write cannot deadlock the program.
+ *
+ * The singleton is the root StopScope of the program: per-request or
+ * per-phase budgets can be created as child scopes of `root()`, and they
+ * expire as well when the global budget or Ctrl-C fires.
  *
- * Expiration is implemented via a background watchdog thread
- * (std::thread) that sets an atomic flag when the deadline is reached.
- * The isExpired() check is therefore a single relaxed atomic load,
- * avoiding repeated clock syscalls in hot loops.
+ * Expiration is implemented via a single, long-lived background watchdog
+ * thread (the DeadlineService) that sets an atomic flag when the deadline is
+ * reached. The isExpired() check is therefore a single relaxed atomic load,
+ * avoiding repeated clock syscalls in hot loops. The budget runs on
+ * VirtualClock, so tests can freeze time and advance it by hand instead of
+ * sleeping.
+ *
+ * While a Tracer is on, start(), stop(), resume(), the expiration, and the
+ * signals are recorded as instant events of category "ExecutionStopper".
+ *
+ * The deadline is an atomic, so it can be moved, extended, or cleared without
+ * recreating the watchdog. Extending or clearing the deadline is a single
+ * atomic store; only when the deadline is brought forward the watchdog is
+ * woken up to sleep again on the new deadline.
  *
  * NOTE: the default expiration time is set to one year (31,536,000 seconds).
  * This is a compromise between having a reasonably long default expiration time
@@ -66,12 +98,75 @@ public:
      * \brief Set the expiration time to stop.
      * \param expiration_time the expiration time in seconds.
      *
-     * If the timer is already running, the watchdog is restarted
+     * If the timer is already running, the watchdog is reprogrammed
      * with the updated deadline.
      */
     static void setExpirationTime(
         std::chrono::seconds expiration_time
     ) noexcept;
+
+    /**
+     * \brief Set a budget of process CPU time, besides the wall-clock one.
+     * \param budget CPU time of all threads together, counted from start()
+     *        and excluding stopped periods. Zero, the default, means no CPU
+     *        budget.
+     * \return false if CPU-time clocks are not available on this system.
+     *
+     * The stopper expires when either budget runs out. The CPU time is
+     * checked by the watchdog at the earliest time the budget could run out
+     * with every core busy, and again after each check until it does, so
+     * far budgets cost a handful of checks and the overshoot stays within a
+     * DeadlineService tick per busy core. The checks are scheduled on the
+     * service time, so with VirtualClock frozen, they only happen as
+     * advance() reaches them.
+     */
+    static bool setCpuTimeBudget(std::chrono::nanoseconds budget) noexcept;
+
+    /**
+     * \brief Set a budget of work units, besides the time ones.
+     * \param units units of work, reported by consume() from all threads
+     *        together since start(). Zero, the default, means no work
+     *        budget.
+     *
+     * The stopper expires when any budget runs out, so a single binary can
+     * stop after a fixed amount of work, which is reproducible across
+     * machines (e.g., for benchmarking), or after a wall-clock deadline
+     * (e.g., in production). Set it before the threads start consuming; if
+     * the work already done exceeds the budget, the stopper expires right
+     * away.
+     */
+    static void setWorkBudget(std::int64_t units) noexcept;
+    //@}
+
+    /** Work accounting */
+    //@{
+    /// The largest quota granted to a thread at once under a work budget.
+    /// Each grant is an atomic update of a shared counter, amortized over
+    /// the units of the quota.
+    static constexpr std::int64_t max_work_chunk = 4096;
+
+    /**
+     * \brief Report `units` of work done by the calling thread.
+     *
+     * Each thread counts on its own cache line, taking quotas from the work
+     * budget in chunks, so the common case is relaxed loads and a store with
+     * no read-modify-write, and threads do not contend. Only the thread
+     * writes its count, so start() and setWorkBudget() take the quotas back
+     * without losing units consumed meanwhile. The stopper expires when a
+     * thread used up its quota and nothing is left to grant: with one
+     * thread, exactly when the budget is used up; with several, short of the
+     * quotas the others hold, which are at most `max_work_chunk` units each,
+     * and shrink as the budget runs out.
+     */
+    static void consume(std::int64_t units = 1) noexcept {
+        auto& shard = workShard();
+        const auto consumed =
+            shard.consumed.load(std::memory_order_relaxed) + units;
+        shard.consumed.store(consumed, std::memory_order_relaxed);
+        const auto limit = shard.limit.load(std::memory_order_relaxed);
+        if(consumed >= limit) [[unlikely]]
+            instance().refillWork(shard);
+    }
     //@}
 
     /** Time retrieval */
@@ -82,6 +177,19 @@ public:
     /// Returns the elapsed time in nanoseconds.
     static std::chrono::nanoseconds elapsedInNanoseconds() noexcept;
 
+    /// Returns the approximate elapsed time in nanoseconds, lagging about a
+    /// millisecond behind, without reading the clock. See
+    /// StopScope::elapsedApprox().
+    static std::chrono::nanoseconds elapsedApprox() noexcept;
+
+    /// Returns the CPU time used by the process since start(), excluding
+    /// stopped periods. Zero if CPU-time clocks are not available.
+    static std::chrono::nanoseconds cpuTimeUsed() noexcept;
+
+    /// Returns the units of work reported by consume() since start(), by
+    /// all threads.
+    static std::int64_t workUsed() noexcept;
+
     /// Return true if the timer has been stopped.
     static bool isStopped() noexcept;
 
@@ -89,6 +197,84 @@ public:
     static bool isExpired() noexcept;
     //@}
 
+    /** Waiting */
+    //@{
+    /**
+     * \brief Block until the timer expires, SIGINT arrives, or the timeout
+     *        elapses.
+     * \param timeout maximum time to wait.
+     * \return true if expired, false on timeout.
+     *
+     * Use it instead of sleeping between isExpired() checks: the caller is
+     * woken up as soon as the stopper expires.
+     */
+    template <class Rep, class Period>
+    static bool waitFor(const std::chrono::duration<Rep, Period>& timeout) {
+        return instance().root_scope.waitFor(timeout);
+    }
+
+    /// Block until the timer expires or SIGINT arrives.
+    static void waitUntilExpired();
+
+    /**
+     * \brief Return a file descriptor that becomes readable on expiration.
+     *
+     * It is an eventfd on Linux (a pipe on other POSIX systems) that becomes
+     * readable when the watchdog expires the timer or SIGINT arrives, so
+     * event loops can wait for it in `poll()`/`epoll_wait()`. It stays
+     * readable until start() is called again. Return -1 on systems without
+     * file descriptors.
+     */
+    static int expiryFd() noexcept;
+    //@}
+
+    /** Coroutines and stop tokens */
+    //@{
+    /**
+     * \brief Return a stop token that is stopped when the timer expires or
+     *        SIGINT arrives.
+     *
+     * Useful to feed `std::stop_callback`s, or anything built on
+     * `std::stop_token`, without extra threads. See StopScope::stopToken().
+     */
+    static std::stop_token stopToken();
+
+    /// Return an awaitable that resumes when the timer expires or SIGINT
+    /// arrives. See StopScope::expired().
+    static ExpiryAwaiter expired() noexcept;
+
+    /// Return an awaitable that resumes after the given duration, or earlier,
+    /// if the timer expires or SIGINT arrives. See StopScope::sleepFor().
+    static ExpiryAwaiter sleepFor(std::chrono::nanoseconds duration) noexcept;
+    //@}
+
+    /** Scopes */
+    //@{
+    /// Return the root scope, to be used as parent of nested scopes.
+    static StopScope& root() noexcept;
+    //@}
+
+    /** Signals */
+    //@{
+    /**
+     * \brief Expire the stopper when the given signal arrives.
+     * \param signum the signal, such as SIGTERM or SIGUSR1. SIGINT is
+     *        handled from the start.
+     * \return true if the handler is installed.
+     *
+     * The first signal expires the stopper and restores the previous handler
+     * of that signal, so sending it once more acts as if the stopper were not
+     * there (for instance, a second Ctrl-C kills the program).
+     */
+    static bool handleSignal(int signum) noexcept;
+
+    /// Stop handling the signal, restoring its previous handler.
+    static void releaseSignal(int signum) noexcept;
+
+    /// Return the last signal that expired the stopper, or 0 if none did.
+    static int lastSignal() noexcept;
+    //@}
+
 private:
     /** \name Private methods to avoid creation and copy */
     //@{
@@ -104,38 +290,180 @@ protected:
     /// Get a reference for an instance.
     static ExecutionStopper& instance();
 
-    /// Function used to emit the STOP signal (Ctrl-C).
+    /// Signal handler. On POSIX systems, it only records the signal and
+    /// wakes the signal thread up, which is async-signal-safe.
     static void userSignalBreak(int signum);
 
-    /// Spawn (or respawn) the watchdog thread for the remaining time.
-    void spawnWatchdog() noexcept;
+    /// Install the signal handler for the signal.
+    bool installHandler(int signum) noexcept;
+
+    /// Restore the previous handler of the signal, if it is handled.
+    void restoreHandler(int signum) noexcept;
+
+    /// Expire the stopper due to a signal and restore its previous handler.
+    void onSignal(int signum) noexcept;
+
+    /// Body of the signal thread.
+    void signalLoop() noexcept;
+
+    /// Record the expiration of the current run, if tracing.
+    void traceExpiry() noexcept;
+
+    /// Return the process CPU time in nanoseconds, or 0 if not available.
+    static std::int64_t processCpuTime() noexcept;
+
+    /// Return the CPU time used since start(), in nanoseconds.
+    std::int64_t cpuTimeUsedNs() const noexcept;
+
+    /// Expire if the CPU budget ran out; otherwise, check again later.
+    void checkCpuBudget() noexcept;
+    //@}
+
+    /// The work quota of a thread, on its own cache line. Only the thread
+    /// writes `consumed`, so consume() needs no read-modify-write; the
+    /// quota is taken back by lowering `limit`, under work_mutex.
+    struct alignas(cache_line_size) WorkShard {
+        /// Register the shard of the calling thread.
+        WorkShard();
+
+        /// Give the unused quota back, and unregister the shard.
+        ~WorkShard();
+
+        WorkShard(const WorkShard&) = delete;
+        WorkShard& operator=(const WorkShard&) = delete;
+
+        /// Return the units granted and not consumed yet. Negative when
+        /// the thread consumed more than it was granted.
+        std::int64_t quota() const noexcept {
+            return limit.load(std::memory_order_relaxed) -
+                   consumed.load(std::memory_order_relaxed);
+        }
+
+        /// Units consumed by the thread, ever.
+        std::atomic<std::int64_t> consumed;
+
+        /// The thread may consume until `consumed` reaches it.
+        std::atomic<std::int64_t> limit;
+    };
+
+    /// Return the calling thread's shard.
+    static WorkShard& workShard() noexcept {
+        thread_local WorkShard shard;
+        return shard;
+    }
+
+    /// Grant more quota to the calling thread's `shard`, or expire if the
+    /// work budget ran out.
+    void refillWork(WorkShard& shard) noexcept;
+
+    /// Take back the quotas of all threads, zeroing the work used if
+    /// `restart`. Units consumed meanwhile overshoot the lowered limits, so
+    /// they are counted on the next refill. Requires work_mutex.
+    void reclaimWork(bool restart) noexcept;
+
+    /// Quota granted at once when there is no work budget, only to count.
+    static constexpr std::int64_t unlimited_work_chunk =
+        std::int64_t {1} << 32;
+
+    /// Calls checkCpuBudget() from the watchdog.
+    struct CpuBudgetCheck: DeadlineNode {
+        explicit CpuBudgetCheck(ExecutionStopper& owner) noexcept:
+            DeadlineNode {},
+            stopper {owner}
+        {}
+
+        void onDeadline() noexcept override { stopper.checkCpuBudget(); }
+
+        ExecutionStopper& stopper;
+    };
+
+    /// Records the expiration in the trace.
+    struct ExpiryTrace {
+        void operator()() const noexcept {
+            Tracer::instant("expire", "ExecutionStopper");
+        }
+    };
+
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    /// Previous action of a signal.
+    using SignalAction = struct sigaction;
+    #else
+    /// Previous handler of a signal.
+    using SignalAction = void (*)(int);
+    #endif
+
+    /// A signal handled by the stopper.
+    struct HandledSignal {
+        /// The signal number.
+        int signum;
+
+        /// Its action before the stopper took it.
+        SignalAction previous;
+    };
+
+    /** \name Data shared with the signal handler */
+    //@{
+    /// One bit per signal received and not yet processed.
+    static inline std::atomic<std::uint64_t> pending_signals {0};
+
+    /// Wakes the signal thread up.
+    static inline NotificationFd signal_notification {};
     //@}
 
     /** \name Data members */
     //@{
-    /// The maximum or expiration time in seconds.
-    std::chrono::seconds expiration_time;
+    /// The root scope, holding the timer and the deadline.
+    StopScope root_scope;
+
+    /// Calls ExpiryTrace when the current run expires, if it is traced.
+    /// Declared after root_scope, so it is unregistered first.
+    std::optional<std::stop_callback<ExpiryTrace>> expiry_trace;
+
+    /// Guards handled_signals.
+    std::mutex signal_mutex;
+
+    /// Signals currently handled, with their previous actions.
+    std::vector<HandledSignal> handled_signals;
+
+    /// The last signal that expired the stopper.
+    std::atomic<int> last_signal;
+
+    /** \name CPU-time budget, in nanoseconds */
+    //@{
+    /// The budget; 0 means none.
+    std::atomic<std::int64_t> cpu_budget;
+
+    /// CPU time used up to the last stop().
+    std::atomic<std::int64_t> cpu_used;
 
-    /// The timer.
-    cea::Timer timer;
+    /// Process CPU time at the last start() or resume(); -1 when stopped.
+    std::atomic<std::int64_t> cpu_resumed_at;
+
+    /// Schedules the budget checks in the watchdog.
+    CpuBudgetCheck cpu_budget_check;
+    //@}
 
-    /// Holds a pointer to the previous Ctrl-C handler.
-    void (*previousHandler)(int);
+    /** \name Work budget, in units */
+    //@{
+    /// The budget; 0 means none.
+    std::atomic<std::int64_t> work_budget;
 
-    /// Indicates expiration (timeout or Ctrl-C).
-    std::atomic<bool> expired;
+    /// Units granted to the threads since start(). The work used is this
+    /// minus the quotas still held by the threads.
+    std::atomic<std::int64_t> work_granted;
 
-    /// Mutex used by the watchdog condition variable.
-    std::mutex watchdog_mutex;
+    /// Guards work_shards, their limits, and the grants.
+    std::mutex work_mutex;
 
-    /// Condition variable for interruptible sleep in the watchdog.
-    std::condition_variable_any watchdog_cv;
+    /// Shards of the threads that consumed work.
+    std::vector<WorkShard*> work_shards;
+    //@}
 
-    /// Cancellation flag for watchdog thread wake up.
-    std::atomic<bool> watchdog_cancelled;
+    /// Asks the signal thread to finish.
+    std::atomic<bool> shutdown;
 
-    /// Background watchdog thread that sets the expired flag.
-    std::thread watchdog;
+    /// Processes the signals outside the signal handler.
+    std::thread signal_thread;
     //@}
 };
 
@@ -152,24 +480,53 @@ protected:
 //------------------[ Default Constructor and Destructor ]--------------------//
 
 inline ExecutionStopper::ExecutionStopper():
+    root_scope {},
+    expiry_trace {},
+    signal_mutex {},
+    handled_signals {},
+    last_signal {0},
+    cpu_budget {0},
+    cpu_used {0},
+    cpu_resumed_at {-1},
+    cpu_budget_check {*this},
+    work_budget {0},
+    work_granted {0},
+    work_mutex {},
+    work_shards {},
+    shutdown {false},
+    signal_thread {}
+{
     // NOTE: we cannot setup the maximum expiration time as
     // seconds::max() because some libraries return 0 instead the max,
     // or use nanoseconds::max() because it would overflow.
-    expiration_time {3600 * 24 * 365},  // 1 year
-    timer {},
-    previousHandler {std::signal(SIGINT, userSignalBreak)},
-    expired {false},
-    watchdog_mutex {},
-    watchdog_cv {},
-    watchdog_cancelled {false},
-    watchdog {}
-{}
+    root_scope.setExpirationTime(std::chrono::seconds {3600 * 24 * 365});
+
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    if(signal_notification.open())
+        signal_thread = std::thread {[this] { signalLoop(); }};
+    #endif
+
+    installHandler(SIGINT);
+}
 
 inline ExecutionStopper::~ExecutionStopper() {
-    watchdog_cancelled.store(true, std::memory_order_relaxed);
-    watchdog_cv.notify_all();
-    if(watchdog.joinable())
-        watchdog.join();
+    DeadlineService::instance().cancel(cpu_budget_check);
+    {
+        std::lock_guard lock(signal_mutex);
+        while(!handled_signals.empty()) {
+            const auto& handled = handled_signals.back();
+            #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+            ::sigaction(handled.signum, &handled.previous, nullptr);
+            #else
+            std::signal(handled.signum, handled.previous);
+            #endif
+            handled_signals.pop_back();
+        }
+    }
+    shutdown.store(true);
+    signal_notification.notify();
+    if(signal_thread.joinable())
+        signal_thread.join();
 }
 
 //--------------------[ Singleton instance initialization ]-------------------//
@@ -179,118 +536,375 @@ inline ExecutionStopper& ExecutionStopper::instance() {
     return inst;
 }
 
-//---------------------[ Watchdog thread management ]-------------------------//
+inline StopScope& ExecutionStopper::root() noexcept {
+    return instance().root_scope;
+}
+
+//--------------------------[ Timer manipulation ]----------------------------//
 
-inline void ExecutionStopper::spawnWatchdog() noexcept {
-    // Destroy any existing watchdog (signal cancel + join).
-    watchdog_cancelled.store(true, std::memory_order_relaxed);
-    watchdog_cv.notify_all();
-    if(watchdog.joinable())
-        watchdog.join();
-    watchdog_cancelled.store(false, std::memory_order_relaxed);
+inline void ExecutionStopper::start() noexcept {
+    auto& stopper = instance();
+    stopper.root_scope.start();
+    stopper.cpu_used.store(0);
+    stopper.cpu_resumed_at.store(processCpuTime());
+    {
+        std::lock_guard lock(stopper.work_mutex);
+        stopper.reclaimWork(true);
+    }
+    Tracer::instant("start", "ExecutionStopper");
+    stopper.traceExpiry();
+    stopper.checkCpuBudget();
+}
+
+inline void ExecutionStopper::stop() noexcept {
+    auto& stopper = instance();
+    stopper.root_scope.stop();
+    const auto resumed_at = stopper.cpu_resumed_at.exchange(-1);
+    if(resumed_at >= 0)
+        stopper.cpu_used.fetch_add(processCpuTime() - resumed_at);
+    Tracer::instant("stop", "ExecutionStopper");
+}
 
+inline void ExecutionStopper::resume() noexcept {
+    auto& stopper = instance();
+    stopper.root_scope.resume();
+    // If already expired, nothing was resumed.
+    if(stopper.root_scope.isStopped())
+        return;
+    auto stopped = std::int64_t {-1};
+    stopper.cpu_resumed_at.compare_exchange_strong(stopped, processCpuTime());
+    Tracer::instant("resume", "ExecutionStopper");
+    stopper.checkCpuBudget();
+}
+
+inline void ExecutionStopper::traceExpiry() noexcept {
+    // start() hands out a new stop token, so the callback is renewed.
+    expiry_trace.reset();
+    if(Tracer::isEnabled())
+        expiry_trace.emplace(root_scope.stopToken(), ExpiryTrace {});
+}
+
+inline void ExecutionStopper::setExpirationTime(
+    std::chrono::seconds expiration_time) noexcept
+{
     // Maximum seconds safely representable as nanoseconds.
     static constexpr auto max_safe_seconds =
         std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::nanoseconds::max());
 
-    // Don't spawn if no meaningful deadline is set.
-    if(expiration_time >= max_safe_seconds)
-        return;
+    instance().root_scope.setExpirationTime(
+        (expiration_time >= max_safe_seconds)?
+        std::chrono::nanoseconds::max() :
+        std::chrono::duration_cast<std::chrono::nanoseconds>(expiration_time));
+}
+
+inline bool ExecutionStopper::setCpuTimeBudget(
+    std::chrono::nanoseconds budget) noexcept
+{
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    auto& stopper = instance();
+    stopper.cpu_budget.store(budget.count() > 0? budget.count() : 0);
+    stopper.checkCpuBudget();
+    return true;
+    #else
+    (void) budget;
+    return false;
+    #endif
+}
+
+//---------------------------[ CPU-time budget ]------------------------------//
 
-    // Compute remaining time until deadline.
-    const auto total_ns =
-        std::chrono::duration_cast<std::chrono::nanoseconds>(expiration_time);
-    const auto elapsed_ns = timer.elapsedInNanoseconds();
-    const auto remaining = total_ns - elapsed_ns;
+inline std::int64_t ExecutionStopper::processCpuTime() noexcept {
+    #if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    return ProcessCpuClock::now().time_since_epoch().count();
+    #else
+    return 0;
+    #endif
+}
+
+inline std::int64_t ExecutionStopper::cpuTimeUsedNs() const noexcept {
+    const auto resumed_at = cpu_resumed_at.load();
+    return cpu_used.load() +
+           (resumed_at >= 0? processCpuTime() - resumed_at : 0);
+}
+
+inline void ExecutionStopper::checkCpuBudget() noexcept {
+    const auto budget = cpu_budget.load();
+    if(budget == 0 || cpu_resumed_at.load() < 0 || root_scope.isExpired())
+        return;
 
-    // Already expired.
-    if(remaining <= std::chrono::nanoseconds{0}) {
-        expired.store(true, std::memory_order_relaxed);
+    const auto used = cpuTimeUsedNs();
+    if(used >= budget) {
+        Tracer::instant("cpu budget", "ExecutionStopper");
+        root_scope.expire();
         return;
     }
 
-    // Spawn a watchdog that sleeps until deadline or explicit cancellation.
-    watchdog = std::thread{[this, remaining] {
-        std::unique_lock lock(watchdog_mutex);
-        const bool cancelled = watchdog_cv.wait_for(
-            lock, remaining,
-            [this] {
-                return watchdog_cancelled.load(std::memory_order_relaxed);
-            }
-        );
-        if(!cancelled)
-            expired.store(true, std::memory_order_relaxed);
-    }};
+    // The CPU time cannot grow faster than one second per second per core,
+    // so the budget cannot run out before this.
+    const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+    const auto wait = std::max((budget - used) / cores, DeadlineService::tick);
+    DeadlineService::instance().schedule(cpu_budget_check,
+                                         DeadlineService::now() + wait);
 }
 
-//--------------------------[ Timer manipulation ]----------------------------//
+//-----------------------------[ Work budget ]--------------------------------//
+
+inline void ExecutionStopper::setWorkBudget(std::int64_t units) noexcept {
+    auto& stopper = instance();
+    std::int64_t used = 0;
+    {
+        std::lock_guard lock(stopper.work_mutex);
+        stopper.work_budget.store(std::max(units, std::int64_t {0}));
+        // The quotas were granted for the former budget.
+        stopper.reclaimWork(false);
+        used = stopper.work_granted.load();
+    }
+    if(units > 0 && used >= units && !stopper.root_scope.isExpired()) {
+        Tracer::instant("work budget", "ExecutionStopper");
+        stopper.root_scope.expire();
+    }
+}
 
-inline void ExecutionStopper::start() noexcept {
-    auto& inst = instance();
-    inst.expired.store(false, std::memory_order_relaxed);
-    inst.timer.start();
-    inst.spawnWatchdog();
+inline std::int64_t ExecutionStopper::workUsed() noexcept {
+    auto& stopper = instance();
+    std::lock_guard lock(stopper.work_mutex);
+    auto used = stopper.work_granted.load();
+    for(const auto* shard : stopper.work_shards)
+        used -= shard->quota();
+    return used;
 }
 
-inline void ExecutionStopper::stop() noexcept {
-    auto& inst = instance();
-    inst.timer.stop();
-    // Kill watchdog (signal cancel + join).
-    inst.watchdog_cancelled.store(true, std::memory_order_relaxed);
-    inst.watchdog_cv.notify_all();
-    if(inst.watchdog.joinable())
-        inst.watchdog.join();
+inline ExecutionStopper::WorkShard::WorkShard():
+    consumed {0},
+    limit {0}
+{
+    auto& stopper = instance();
+    std::lock_guard lock(stopper.work_mutex);
+    stopper.work_shards.push_back(this);
 }
 
-inline void ExecutionStopper::resume() noexcept {
-    auto& inst = instance();
-    // If already expired, nothing to resume.
-    if(inst.expired.load(std::memory_order_relaxed))
-        return;
-    inst.timer.resume();
-    inst.spawnWatchdog();
+inline ExecutionStopper::WorkShard::~WorkShard() {
+    auto& stopper = instance();
+    std::lock_guard lock(stopper.work_mutex);
+    // What is left goes back to the pool; an overshoot stays counted.
+    stopper.work_granted.fetch_sub(quota());
+    auto& shards = stopper.work_shards;
+    shards.erase(std::remove(shards.begin(), shards.end(), this),
+                 shards.end());
 }
 
-inline void ExecutionStopper::setExpirationTime(
-    std::chrono::seconds expiration_time) noexcept
-{
-    auto& inst = instance();
-    inst.expiration_time = expiration_time;
-    // If the timer is running, restart the watchdog with the new deadline.
-    if(!inst.timer.isStopped())
-        inst.spawnWatchdog();
+inline void ExecutionStopper::reclaimWork(bool restart) noexcept {
+    auto reclaimed = std::int64_t {0};
+    for(auto* shard : work_shards) {
+        // The owner may be consuming: read its count once, and stop it there.
+        const auto consumed = shard->consumed.load(std::memory_order_relaxed);
+        reclaimed += shard->limit.load(std::memory_order_relaxed) - consumed;
+        shard->limit.store(consumed, std::memory_order_relaxed);
+    }
+    if(restart)
+        work_granted.store(0);
+    else
+        work_granted.fetch_sub(reclaimed);
+}
+
+inline void ExecutionStopper::refillWork(WorkShard& shard) noexcept {
+    // Each chunk is a share of what is left, so the quotas held by the
+    // other threads shrink as the budget runs out.
+    static const auto cores = static_cast<std::int64_t>(
+        std::max(std::thread::hardware_concurrency(), 1u));
+
+    auto quota = std::int64_t {0};
+    {
+        std::lock_guard lock(work_mutex);
+        quota = shard.quota();
+        const auto budget = work_budget.load();
+        const auto granted = work_granted.load();
+        if(budget == 0) {
+            work_granted.store(granted + unlimited_work_chunk - quota);
+            quota = unlimited_work_chunk;
+        }
+        else if(quota <= 0 && granted < budget) {
+            const auto left = budget - granted;
+            const auto share = std::clamp(left / (2 * cores),
+                                          std::int64_t {1}, max_work_chunk);
+            const auto chunk = std::min(left, share - quota);
+            work_granted.store(granted + chunk);
+            quota += chunk;
+        }
+        // Only this thread moves its count, so it is still the same.
+        shard.limit.store(shard.consumed.load(std::memory_order_relaxed) +
+                          quota, std::memory_order_relaxed);
+    }
+
+    // Unlocked, as stop callbacks may consume work.
+    if(quota <= 0 && !root_scope.isExpired()) {
+        Tracer::instant("work budget", "ExecutionStopper");
+        root_scope.expire();
+    }
 }
 
 //----------------------------[ Time retrieval ]------------------------------//
 
 inline std::chrono::seconds ExecutionStopper::elapsed() noexcept {
-    return instance().timer.elapsed();
+    return instance().root_scope.elapsed();
 }
 
 inline std::chrono::nanoseconds
 ExecutionStopper::elapsedInNanoseconds() noexcept {
-    return instance().timer.elapsedInNanoseconds();
+    return instance().root_scope.elapsedInNanoseconds();
+}
+
+inline std::chrono::nanoseconds ExecutionStopper::elapsedApprox() noexcept {
+    return instance().root_scope.elapsedApprox();
+}
+
+inline std::chrono::nanoseconds ExecutionStopper::cpuTimeUsed() noexcept {
+    return std::chrono::nanoseconds {instance().cpuTimeUsedNs()};
 }
 
 inline bool ExecutionStopper::isStopped() noexcept {
-    return instance().timer.isStopped();
+    return instance().root_scope.isStopped();
 }
 
 //-----------------------------[ Timer expired ]------------------------------//
 
 inline bool ExecutionStopper::isExpired() noexcept {
-    return instance().expired.load(std::memory_order_relaxed);
+    return instance().root_scope.isExpired();
+}
+
+//--------------------------------[ Waiting ]---------------------------------//
+
+inline void ExecutionStopper::waitUntilExpired() {
+    instance().root_scope.waitUntilExpired();
+}
+
+inline int ExecutionStopper::expiryFd() noexcept {
+    return instance().root_scope.expiryFd();
+}
+
+inline std::stop_token ExecutionStopper::stopToken() {
+    return instance().root_scope.stopToken();
+}
+
+inline ExpiryAwaiter ExecutionStopper::expired() noexcept {
+    return instance().root_scope.expired();
 }
 
-//----------------------------[ Ctrl-C handler ]------------------------------//
+inline ExpiryAwaiter ExecutionStopper::sleepFor(
+    std::chrono::nanoseconds duration) noexcept
+{
+    return instance().root_scope.sleepFor(duration);
+}
+
+//------------------------------[ Signals ]-----------------------------------//
+
+inline bool ExecutionStopper::handleSignal(int signum) noexcept {
+    return instance().installHandler(signum);
+}
+
+inline void ExecutionStopper::releaseSignal(int signum) noexcept {
+    instance().restoreHandler(signum);
+}
+
+inline int ExecutionStopper::lastSignal() noexcept {
+    return instance().last_signal.load();
+}
+
+inline bool ExecutionStopper::installHandler(int signum) noexcept {
+    // Signals must fit in the pending bitmask.
+    if(signum <= 0 || signum >= 64)
+        return false;
+
+    std::lock_guard lock(signal_mutex);
+    for(const auto& handled : handled_signals)
+        if(handled.signum == signum)
+            return true;
+
+    HandledSignal handled {signum, {}};
+
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    if(!signal_thread.joinable())
+        return false;
+    struct sigaction action {};
+    action.sa_handler = userSignalBreak;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    if(::sigaction(signum, &action, &handled.previous) != 0)
+        return false;
+    #else
+    handled.previous = std::signal(signum, userSignalBreak);
+    if(handled.previous == SIG_ERR)
+        return false;
+    #endif
+
+    handled_signals.push_back(handled);
+    return true;
+}
+
+inline void ExecutionStopper::restoreHandler(int signum) noexcept {
+    std::lock_guard lock(signal_mutex);
+    for(auto it = handled_signals.begin(); it != handled_signals.end(); ++it) {
+        if(it->signum != signum)
+            continue;
+        #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+        ::sigaction(signum, &it->previous, nullptr);
+        #else
+        std::signal(signum, it->previous);
+        #endif
+        handled_signals.erase(it);
+        return;
+    }
+}
+
+inline void ExecutionStopper::userSignalBreak(int signum) {
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    // Only async-signal-safe operations here: a lock-free atomic and write().
+    // The write() may change errno, which the interrupted code may be about
+    // to read.
+    const int saved_errno = errno;
+    pending_signals.fetch_or(std::uint64_t {1} << signum);
+    signal_notification.notify();
+    errno = saved_errno;
+    #else
+    // Without sigaction, the handler runs in a thread of its own (Windows)
+    // or there is nothing better to do.
+    instance().onSignal(signum);
+    #endif
+}
+
+inline void ExecutionStopper::signalLoop() noexcept {
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    pollfd entry {signal_notification.fd(), POLLIN, 0};
+    while(!shutdown.load()) {
+        // EINTR and spurious wake-ups just go around.
+        if(::poll(&entry, 1, -1) <= 0)
+            continue;
+        signal_notification.drain();
+        auto pending = pending_signals.exchange(0);
+        for(int signum = 0; pending != 0; ++signum, pending >>= 1)
+            if((pending & 1) != 0)
+                onSignal(signum);
+    }
+    #endif
+}
 
-inline void ExecutionStopper::userSignalBreak(int /*signum*/) {
-    instance().expired.store(true, std::memory_order_relaxed);
-    std::signal(SIGINT, instance().previousHandler);
-    std::cerr << "\n\n> Ctrl-C detected. Aborting execution. "
-              << "Type Ctrl-C once more for exit immediately."
-              << std::endl;
+inline void ExecutionStopper::onSignal(int signum) noexcept {
+    last_signal.store(signum);
+    Tracer::instant(signum == SIGINT? "SIGINT" :
+                    signum == SIGTERM? "SIGTERM" : "signal",
+                    "ExecutionStopper");
+    root_scope.expire();
+    restoreHandler(signum);
+
+    if(signum == SIGINT)
+        std::cerr << "\n\n> Ctrl-C detected. Aborting execution. "
+                  << "Type Ctrl-C once more for exit immediately."
+                  << std::endl;
+    else
+        std::cerr << "\n\n> Signal " << signum << " received. Aborting "
+                  << "execution. Send it once more for exit immediately."
+                  << std::endl;
 }
 
 } // end of namespace cea
@@ -0,0 +1,228 @@
+/******************************************************************************
+ * @file expiry_checkpoint.hpp
+ * @brief Interface for the BasicExpiryCheckpoint class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/clocks.hpp"
+#include "timer/execution_stopper.hpp"
+#include "timer/stop_scope.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace cea {
+
+/**
+ * \brief BasicExpiryCheckpoint class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Checks a StopScope (by default, the ExecutionStopper) only once every
+ * `interval()` iterations of a tight loop. Even a relaxed atomic load on
+ * every iteration keeps the compiler from unrolling and vectorizing the
+ * loop; forEach() runs the iterations between checks as a plain loop:
+ *
+ * \code
+ *     cea::ExpiryCheckpoint checkpoint;  // Adapted to check every ~1 ms.
+ *     const auto done = checkpoint.forEach(std::size_t {0}, values.size(),
+ *         [&](std::size_t i) { values[i] = a * x[i] + y[i]; });
+ *     if(done < values.size())
+ *         // Expired.
+ * \endcode
+ *
+ * Loops that cannot be split into blocks can call isExpired() on each
+ * iteration instead; it costs a decrement and a branch on a member, with
+ * no atomic load, but it is still a loop exit on every iteration.
+ *
+ * With `Interval` greater than zero, the interval is fixed at compile time.
+ * With `Interval` zero (the default), it is adapted at runtime so the time
+ * between checks, read from `Clock` at each check, stays between a quarter
+ * and a half of the target latency: it doubles while the checks are too
+ * close, and shrinks in proportion when they are too far apart. The
+ * response to an expiration is then delayed by at most the target latency,
+ * plus the latency of the scope itself. The first intervals are short, as
+ * the adaptation starts from one iteration.
+ *
+ * A checkpoint is single-threaded, like the loop it is in: use one per
+ * thread. Once the scope expired, every check consults it again, so the
+ * expiration is never missed between loops.
+ *
+ * \tparam Clock the clock policy read at each check, only when adaptive.
+ * \tparam Interval the fixed checking interval, or zero for an adaptive one.
+ */
+template <class Clock = TscClock, std::uint64_t Interval = 0>
+class BasicExpiryCheckpoint {
+public:
+    /// The clock policy used to adapt the interval.
+    using clock = Clock;
+
+    /// Whether the interval adapts to a target latency.
+    static constexpr bool is_adaptive = Interval == 0;
+
+    /// The largest adaptive interval.
+    static constexpr std::uint64_t max_interval = std::uint64_t {1} << 24;
+
+    /** \name Constructor */
+    //@{
+    /**
+     * \brief Build a checkpoint.
+     * \param stop_scope the scope to check.
+     * \param target_latency the longest time between checks of the
+     *        adaptive interval; ignored with a fixed interval.
+     */
+    explicit BasicExpiryCheckpoint(
+        const StopScope& stop_scope = ExecutionStopper::root(),
+        std::chrono::nanoseconds target_latency =
+            std::chrono::milliseconds {1}) noexcept:
+        scope {&stop_scope},
+        target {std::max(target_latency.count(), std::int64_t {4})},
+        check_interval {is_adaptive? 1 : Interval},
+        countdown {check_interval},
+        last_check {Clock::now()}
+    {
+        static_assert(Interval <= max_interval,
+                      "The checking interval is too large");
+    }
+    //@}
+
+    /** \name Checks */
+    //@{
+    /**
+     * \brief Return true if the scope expired, consulting it only once
+     *        every `interval()` calls.
+     *
+     * Meant to be called on every iteration of a loop that cannot be
+     * split in blocks; see forEach() otherwise.
+     */
+    bool isExpired() noexcept {
+        if(--countdown != 0) [[likely]]
+            return false;
+        return check();
+    }
+
+    /**
+     * \brief Call `body(i)` for each `i` in `[first, last)`, checking the
+     *        scope between blocks of `interval()` iterations.
+     * \return `last` if all iterations ran, or the first one that did not,
+     *         if the scope expired.
+     *
+     * The blocks are plain loops over `body`, so the compiler can unroll
+     * and vectorize them. The countdown carries over between calls, so
+     * short ranges are checked as rarely as long ones.
+     */
+    template <class Index, class Body>
+    Index forEach(Index first, Index last, Body&& body);
+
+    /// Restart the adaptation timing and the countdown, e.g., after the
+    /// thread spent a while outside the loop.
+    void reset() noexcept {
+        countdown = check_interval;
+        last_check = Clock::now();
+    }
+    //@}
+
+    /** \name Queries */
+    //@{
+    /// Return the number of iterations between checks.
+    std::uint64_t interval() const noexcept {
+        return check_interval;
+    }
+
+    /// Return the target latency of the adaptive interval.
+    std::chrono::nanoseconds targetLatency() const noexcept {
+        return std::chrono::nanoseconds {target};
+    }
+    //@}
+
+protected:
+    /// Consult the scope, adapt the interval, and restart the countdown.
+    bool check() noexcept;
+
+    /** \name Data members */
+    //@{
+    /// The scope to check.
+    const StopScope* scope;
+
+    /// The target latency, in nanoseconds.
+    std::int64_t target;
+
+    /// Iterations between checks.
+    std::uint64_t check_interval;
+
+    /// Iterations left until the next check.
+    std::uint64_t countdown;
+
+    /// Time of the last check, when adaptive.
+    typename Clock::time_point last_check;
+    //@}
+};
+
+/// The default checkpoint: adaptive, timed with TscClock.
+using ExpiryCheckpoint = BasicExpiryCheckpoint<TscClock>;
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+template <class Clock, std::uint64_t Interval>
+template <class Index, class Body>
+inline Index BasicExpiryCheckpoint<Clock, Interval>::forEach(
+    Index first, Index last, Body&& body)
+{
+    while(first < last) {
+        const auto block = static_cast<Index>(std::min(
+            countdown, static_cast<std::uint64_t>(last - first)));
+        const auto end = first + block;
+        for(auto i = first; i < end; ++i)
+            body(i);
+        first = end;
+        countdown -= static_cast<std::uint64_t>(block);
+        if(countdown == 0 && check())
+            break;
+    }
+    return first;
+}
+
+template <class Clock, std::uint64_t Interval>
+inline bool BasicExpiryCheckpoint<Clock, Interval>::check() noexcept {
+    if(scope->isExpired()) {
+        // Check again on the next call.
+        countdown = 1;
+        return true;
+    }
+
+    if constexpr(is_adaptive) {
+        const auto now = Clock::now();
+        const auto elapsed = std::max(std::int64_t {1},
+            static_cast<std::int64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now - last_check).count()));
+        last_check = now;
+
+        // Keep the time between checks within [target / 4, target / 2].
+        const auto high = target / 2;
+        if(elapsed > high)
+            check_interval = std::max(std::uint64_t {1},
+                static_cast<std::uint64_t>(
+                    static_cast<double>(check_interval) *
+                    static_cast<double>(high) /
+                    static_cast<double>(elapsed)));
+        else if(elapsed < target / 4)
+            check_interval = std::min(2 * check_interval, max_interval);
+    }
+
+    countdown = check_interval;
+    return false;
+}
+
+} // end of namespace cea
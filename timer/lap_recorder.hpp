@@ -0,0 +1,414 @@
+/******************************************************************************
+ * @file lap_recorder.hpp
+ * @brief Interface for the BasicLapRecorder class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <ostream>
+
+namespace cea {
+
+/// What a LapRecorder does with laps once its arena is full.
+enum class LapOverflow {
+    /// Overwrite the oldest laps, keeping the latest ones.
+    ring,
+
+    /// Keep the first laps, dropping the following ones.
+    drop,
+
+    /// Keep one lap in every `stride`, doubling the stride (and discarding
+    /// every other lap kept) each time the arena fills up, so the laps kept
+    /// always span the whole run evenly.
+    sampled
+};
+
+/**
+ * \brief LapSummary class.
+ *
+ * Statistics of the intervals between the laps kept by a LapRecorder.
+ */
+struct LapSummary {
+    /// Number of intervals.
+    std::size_t intervals {0};
+
+    /// Laps in each interval: the stride of the sampled policy, else 1.
+    std::uint64_t laps_per_interval {1};
+
+    /// Shortest interval, per lap.
+    std::chrono::nanoseconds min {0};
+
+    /// Longest interval, per lap.
+    std::chrono::nanoseconds max {0};
+
+    /// Mean interval, per lap.
+    std::chrono::nanoseconds mean {0};
+};
+
+/**
+ * \brief BasicLapRecorder class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Records lap timestamps into an arena allocated once, at construction:
+ *
+ * \code
+ *     cea::LapRecorder laps(100'000, cea::LapOverflow::sampled);
+ *     laps.start();
+ *     for(std::size_t i = 0; i < num_iterations; ++i) {
+ *         iterate();
+ *         laps.lap();
+ *     }
+ *     const auto summary = laps.summary();
+ *     std::cout << summary.mean << " per iteration, worst "
+ *               << summary.max << std::endl;
+ * \endcode
+ *
+ * `lap()` and `split()` both record the current time; the first returns the
+ * time since the previous lap, and the second, the time since start().
+ * Recording never allocates nor locks: it reads the clock and stores one
+ * integer. The arena is zeroed at construction, so its pages are mapped
+ * before the first lap. With LapOverflow::sampled, a full arena is compacted
+ * in place, so a lap costs amortized O(1).
+ *
+ * The laps are stored as nanoseconds since start(), in plain arrays, so
+ * exporting them (copyTimestamps(), copyDeltas(), writeCsv()) is a copy, and
+ * summary() computes the deltas, minimum, and maximum in a loop the compiler
+ * vectorizes.
+ *
+ * Like BasicTimer, it is meant for a single thread.
+ *
+ * \tparam Clock the clock policy used to read the current time.
+ */
+template <class Clock = steady_clock>
+class BasicLapRecorder {
+public:
+    /// The clock policy used by this recorder.
+    using clock = Clock;
+
+    /** \name Constructor */
+    //@{
+    /**
+     * \brief Build a recorder.
+     * \param capacity the number of laps kept (at least one).
+     * \param overflow what to do with laps once `capacity` are kept.
+     */
+    explicit BasicLapRecorder(std::size_t capacity,
+                              LapOverflow overflow = LapOverflow::ring):
+        arena_capacity {std::max(capacity, std::size_t {1})},
+        overflow_policy {overflow},
+        arena {std::make_unique<std::int64_t[]>(arena_capacity)},
+        num_kept {0},
+        ring_head {0},
+        sampling_stride {1},
+        num_laps {0},
+        last_lap {0},
+        start_time {Clock::now()}
+    {}
+    //@}
+
+    /** Recording */
+    //@{
+    /// Start recording, discarding the laps so far.
+    void start() noexcept {
+        num_kept = 0;
+        ring_head = 0;
+        sampling_stride = 1;
+        num_laps = 0;
+        last_lap = 0;
+        start_time = Clock::now();
+    }
+
+    /// Record a lap and return the time since the previous one (or since
+    /// start()).
+    std::chrono::nanoseconds lap() noexcept {
+        const auto now = sinceStart();
+        const auto delta = now - last_lap;
+        record(now);
+        return std::chrono::nanoseconds {delta};
+    }
+
+    /// Record a lap and return the time since start().
+    std::chrono::nanoseconds split() noexcept {
+        const auto now = sinceStart();
+        record(now);
+        return std::chrono::nanoseconds {now};
+    }
+    //@}
+
+    /** Queries */
+    //@{
+    /// Return the number of laps recorded since start().
+    std::uint64_t numLaps() const noexcept {
+        return num_laps;
+    }
+
+    /// Return the number of laps kept in the arena.
+    std::size_t size() const noexcept {
+        return num_kept;
+    }
+
+    /// Return the number of laps the arena holds.
+    std::size_t capacity() const noexcept {
+        return arena_capacity;
+    }
+
+    /// Return the overflow policy.
+    LapOverflow overflow() const noexcept {
+        return overflow_policy;
+    }
+
+    /// Return the number of laps each kept one stands for: the current
+    /// stride of the sampled policy, else 1.
+    std::uint64_t stride() const noexcept {
+        return sampling_stride;
+    }
+
+    /**
+     * \brief Return the index, counting from zero since start(), of the
+     *        `position`-th lap kept, in chronological order.
+     */
+    std::uint64_t lapIndex(std::size_t position) const noexcept {
+        switch(overflow_policy) {
+        case LapOverflow::ring:
+            return num_laps - num_kept + position;
+        case LapOverflow::drop:
+            return position;
+        case LapOverflow::sampled:
+            break;
+        }
+        return (position + 1) * sampling_stride - 1;
+    }
+    //@}
+
+    /** Export and post-processing */
+    //@{
+    /// Copy the laps kept, as nanoseconds since start(), in chronological
+    /// order. Return the output iterator past the last copied.
+    template <class OutputIterator>
+    OutputIterator copyTimestamps(OutputIterator output) const;
+
+    /// Copy the intervals between the laps kept, in nanoseconds and
+    /// chronological order. Return the output iterator past the last copied.
+    template <class OutputIterator>
+    OutputIterator copyDeltas(OutputIterator output) const;
+
+    /// Return the statistics of the intervals between the laps kept.
+    LapSummary summary() const noexcept;
+
+    /// Write the laps kept as CSV: lap index, time since start(), and
+    /// interval since the previous lap kept, in nanoseconds.
+    void writeCsv(std::ostream& output) const;
+    //@}
+
+protected:
+    /// Return the nanoseconds since start().
+    std::int64_t sinceStart() const noexcept {
+        return duration_cast<nanoseconds>(Clock::now() - start_time).count();
+    }
+
+    /// Store a lap taken `time` nanoseconds since start().
+    void record(std::int64_t time) noexcept {
+        last_lap = time;
+        const auto lap_number = ++num_laps;
+        switch(overflow_policy) {
+        case LapOverflow::ring:
+            arena[ring_head] = time;
+            if(++ring_head == arena_capacity)
+                ring_head = 0;
+            if(num_kept < arena_capacity)
+                ++num_kept;
+            break;
+
+        case LapOverflow::drop:
+            if(num_kept < arena_capacity)
+                arena[num_kept++] = time;
+            break;
+
+        case LapOverflow::sampled:
+            if((lap_number & (sampling_stride - 1)) != 0)
+                return;
+            if(num_kept == arena_capacity) {
+                compact();
+                if((lap_number & (sampling_stride - 1)) != 0)
+                    return;
+            }
+            arena[num_kept++] = time;
+            break;
+        }
+    }
+
+    /// Keep every other lap and double the stride.
+    void compact() noexcept {
+        for(std::size_t i = 0; 2 * i + 1 < num_kept; ++i)
+            arena[i] = arena[2 * i + 1];
+        num_kept /= 2;
+        sampling_stride *= 2;
+    }
+
+    /// Call `visit(pointer, count)` for the one or two contiguous runs of
+    /// laps kept, in chronological order.
+    template <class Visitor>
+    void forEachRun(Visitor&& visit) const {
+        if(overflow_policy == LapOverflow::ring && num_kept == arena_capacity &&
+           ring_head != 0) {
+            visit(arena.get() + ring_head, arena_capacity - ring_head);
+            visit(arena.get(), ring_head);
+        }
+        else {
+            visit(arena.get(), num_kept);
+        }
+    }
+
+    /// Return true if the first lap kept follows start() directly (or, in
+    /// the sampled policy, by one stride), so its interval is known.
+    bool firstFollowsStart() const noexcept {
+        return overflow_policy != LapOverflow::ring || num_laps == num_kept;
+    }
+
+    /** \name Data members */
+    //@{
+    /// Number of laps the arena holds.
+    const std::size_t arena_capacity;
+
+    /// What to do with laps once the arena is full.
+    const LapOverflow overflow_policy;
+
+    /// The laps kept, in nanoseconds since start().
+    std::unique_ptr<std::int64_t[]> arena;
+
+    /// Number of laps kept.
+    std::size_t num_kept;
+
+    /// Next slot to write in the ring policy.
+    std::size_t ring_head;
+
+    /// One lap in every `sampling_stride` is kept (sampled policy).
+    std::uint64_t sampling_stride;
+
+    /// Number of laps since start().
+    std::uint64_t num_laps;
+
+    /// Time of the last lap, in nanoseconds since start().
+    std::int64_t last_lap;
+
+    /// Time of start().
+    typename Clock::time_point start_time;
+    //@}
+};
+
+/// The default lap recorder, based on `std::chrono::steady_clock`.
+using LapRecorder = BasicLapRecorder<steady_clock>;
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+template <class Clock>
+template <class OutputIterator>
+OutputIterator BasicLapRecorder<Clock>::copyTimestamps(
+        OutputIterator output) const {
+    forEachRun([&output](const std::int64_t* laps, std::size_t count) {
+        output = std::copy(laps, laps + count, output);
+    });
+    return output;
+}
+
+template <class Clock>
+template <class OutputIterator>
+OutputIterator BasicLapRecorder<Clock>::copyDeltas(
+        OutputIterator output) const {
+    bool first = true;
+    std::int64_t previous = 0;
+    forEachRun([&](const std::int64_t* laps, std::size_t count) {
+        if(count == 0)
+            return;
+        if(!first || firstFollowsStart())
+            *output++ = laps[0] - previous;
+        first = false;
+        output = std::transform(laps + 1, laps + count, laps, output,
+                                std::minus<std::int64_t> {});
+        previous = laps[count - 1];
+    });
+    return output;
+}
+
+template <class Clock>
+LapSummary BasicLapRecorder<Clock>::summary() const noexcept {
+    LapSummary result;
+    result.laps_per_interval = overflow_policy == LapOverflow::sampled?
+                               sampling_stride : 1;
+
+    auto min = std::numeric_limits<std::int64_t>::max();
+    auto max = std::numeric_limits<std::int64_t>::min();
+    std::size_t intervals = 0;
+    bool first = true;
+    std::int64_t previous = 0;
+    std::int64_t begin = 0;
+    forEachRun([&](const std::int64_t* laps, std::size_t count) {
+        if(count == 0)
+            return;
+        if(!first || firstFollowsStart()) {
+            min = std::min(min, laps[0] - previous);
+            max = std::max(max, laps[0] - previous);
+            ++intervals;
+        }
+        else {
+            begin = laps[0];
+        }
+        first = false;
+        // Branch-free, so it is vectorized.
+        for(std::size_t i = 1; i < count; ++i) {
+            const auto delta = laps[i] - laps[i - 1];
+            min = std::min(min, delta);
+            max = std::max(max, delta);
+        }
+        intervals += count - 1;
+        previous = laps[count - 1];
+    });
+
+    if(intervals == 0)
+        return result;
+    // The intervals add up to the time between the first and last laps.
+    const auto laps = static_cast<std::int64_t>(result.laps_per_interval);
+    result.intervals = intervals;
+    result.min = std::chrono::nanoseconds {min / laps};
+    result.max = std::chrono::nanoseconds {max / laps};
+    result.mean = std::chrono::nanoseconds {
+        (previous - begin) / static_cast<std::int64_t>(intervals) / laps};
+    return result;
+}
+
+template <class Clock>
+void BasicLapRecorder<Clock>::writeCsv(std::ostream& output) const {
+    output << "lap,time_ns,delta_ns\n";
+    std::size_t position = 0;
+    std::int64_t previous = 0;
+    forEachRun([&](const std::int64_t* laps, std::size_t count) {
+        for(std::size_t i = 0; i < count; ++i, ++position) {
+            output << lapIndex(position) << ',' << laps[i] << ',';
+            if(position > 0 || firstFollowsStart())
+                output << laps[i] - previous;
+            output << '\n';
+            previous = laps[i];
+        }
+    });
+}
+
+} // end of namespace cea
@@ -0,0 +1,409 @@
+/******************************************************************************
+ * @file latency_histogram.hpp
+ * @brief Interface for the LatencyHistogram class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+
+namespace cea {
+
+/**
+ * \brief LatencyHistogram class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A fixed-memory, log-linear (HDR-style) histogram of latencies in
+ * nanoseconds, typically fed with `Timer::elapsedInNanoseconds()`:
+ *
+ * \code
+ *     cea::LatencyHistogram histogram;
+ *     cea::Timer timer;
+ *     for(auto& request : requests) {
+ *         timer.start();
+ *         serve(request);
+ *         histogram.record(timer.elapsedInNanoseconds());
+ *     }
+ *     std::cout << histogram.valueAtPercentile(99.9) << std::endl;
+ * \endcode
+ *
+ * Values below 128 ns are recorded exactly. Above that, each power of two is
+ * split into 128 linear buckets, so any value is known within 1/128 (0.78%)
+ * of itself. Values up to 2^44 ns (about 4.9 hours) are tracked; larger ones
+ * are counted in the last bucket. This is 4864 counters, about 38 KB, all
+ * inside the object: recording is O(1) (a bit scan, a shift, and an add),
+ * and never allocates.
+ *
+ * Recording is single-writer: each thread records into a histogram of its
+ * own, without locks nor read-modify-write instructions. The counters are
+ * relaxed atomics, so other threads can read or merge the histogram while
+ * it is being recorded into. Since all histograms share the same buckets,
+ * merging them is lossless: merge() just adds the counters.
+ *
+ * serialize() and deserialize() save and load the histogram as text (only
+ * the non-empty buckets), so the histograms of several runs can be compared.
+ */
+class LatencyHistogram {
+public:
+    /** \name Layout */
+    //@{
+    /// Each power of two is split into 2^sub_bucket_bits buckets.
+    static constexpr unsigned sub_bucket_bits = 7;
+
+    /// Values up to 2^max_value_bits - 1 nanoseconds are tracked.
+    static constexpr unsigned max_value_bits = 44;
+
+    /// Number of buckets per power of two.
+    static constexpr std::uint64_t sub_bucket_count =
+        std::uint64_t {1} << sub_bucket_bits;
+
+    /// Largest tracked value; larger values are counted as this one.
+    static constexpr std::uint64_t max_value =
+        (std::uint64_t {1} << max_value_bits) - 1;
+
+    /// Total number of buckets.
+    static constexpr std::size_t num_buckets =
+        (max_value_bits - sub_bucket_bits + 1) * sub_bucket_count;
+    //@}
+
+    /** \name Constructor and destructor */
+    //@{
+    /// Build an empty histogram.
+    LatencyHistogram() noexcept;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    //@}
+
+    /** Recording (single writer) */
+    //@{
+    /// Record a latency. Negative values are recorded as zero.
+    void record(std::chrono::nanoseconds latency) noexcept {
+        const auto value = static_cast<std::uint64_t>(
+            latency.count() > 0? latency.count() : 0);
+        add(counts[bucketOf(value)], std::uint64_t {1});
+        add(total_count, std::uint64_t {1});
+        add(total_sum, value);
+        if(value < min_value.load(std::memory_order_relaxed))
+            min_value.store(value, std::memory_order_relaxed);
+        if(value > max_recorded.load(std::memory_order_relaxed))
+            max_recorded.store(value, std::memory_order_relaxed);
+    }
+
+    /// Record the elapsed time of a timer (any class with
+    /// `elapsedInNanoseconds()`, such as Timer or StopScope).
+    template <class AnyTimer>
+    void recordElapsed(const AnyTimer& timer) noexcept {
+        record(timer.elapsedInNanoseconds());
+    }
+
+    /// Add all samples of another histogram to this one.
+    void merge(const LatencyHistogram& other) noexcept;
+
+    /// Remove all samples.
+    void clear() noexcept;
+    //@}
+
+    /** Queries (any thread) */
+    //@{
+    /// Return the number of samples.
+    std::uint64_t count() const noexcept {
+        return total_count.load(std::memory_order_relaxed);
+    }
+
+    /// Return the smallest sample, or zero if empty.
+    std::chrono::nanoseconds min() const noexcept;
+
+    /// Return the largest sample, or zero if empty.
+    std::chrono::nanoseconds max() const noexcept {
+        return std::chrono::nanoseconds {
+            static_cast<std::int64_t>(
+                max_recorded.load(std::memory_order_relaxed))};
+    }
+
+    /// Return the mean of the samples, or zero if empty.
+    std::chrono::nanoseconds mean() const noexcept;
+
+    /**
+     * \brief Return the value at the given percentile.
+     * \param percentile a value in [0, 100], such as 50, 99, or 99.9.
+     *
+     * The result is the largest value equivalent (within the bucket
+     * resolution) to the sample at that rank, and is never above max().
+     * Return zero if empty.
+     */
+    std::chrono::nanoseconds valueAtPercentile(double percentile) const
+        noexcept;
+
+    /// Return the number of samples in the bucket of the given value.
+    std::uint64_t countAt(std::chrono::nanoseconds value) const noexcept;
+
+    /// Print the count, mean, max, and the usual percentiles.
+    void printSummary(std::ostream& output) const;
+    //@}
+
+    /** Serialization */
+    //@{
+    /// Write the histogram as text, one line per non-empty bucket.
+    void serialize(std::ostream& output) const;
+
+    /**
+     * \brief Read a histogram written by serialize(), replacing this one.
+     * \return false if the input is not a valid histogram; this histogram is
+     *         then left empty.
+     */
+    bool deserialize(std::istream& input);
+    //@}
+
+    /** \name Bucket layout */
+    //@{
+    /// Return the bucket of a value.
+    static constexpr std::size_t bucketOf(std::uint64_t value) noexcept {
+        if(value > max_value)
+            value = max_value;
+        if(value < sub_bucket_count)
+            return static_cast<std::size_t>(value);
+        const unsigned shift =
+            static_cast<unsigned>(std::bit_width(value)) - 1 - sub_bucket_bits;
+        return (shift + 1) * sub_bucket_count +
+               static_cast<std::size_t>((value >> shift) - sub_bucket_count);
+    }
+
+    /// Return the smallest value of a bucket.
+    static constexpr std::uint64_t lowestOf(std::size_t bucket) noexcept {
+        if(bucket < sub_bucket_count)
+            return bucket;
+        const auto shift = bucket / sub_bucket_count - 1;
+        return (sub_bucket_count + bucket % sub_bucket_count) << shift;
+    }
+
+    /// Return the largest value of a bucket.
+    static constexpr std::uint64_t highestOf(std::size_t bucket) noexcept {
+        if(bucket < sub_bucket_count)
+            return bucket;
+        const auto shift = bucket / sub_bucket_count - 1;
+        return lowestOf(bucket) + (std::uint64_t {1} << shift) - 1;
+    }
+    //@}
+
+protected:
+    /// Single-writer increment: no read-modify-write needed.
+    static void add(std::atomic<std::uint64_t>& counter,
+                    std::uint64_t value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                      std::memory_order_relaxed);
+    }
+
+    /** \name Data members */
+    //@{
+    /// Number of samples.
+    std::atomic<std::uint64_t> total_count;
+
+    /// Sum of the samples, for the mean.
+    std::atomic<std::uint64_t> total_sum;
+
+    /// Smallest sample; max() of uint64_t when empty.
+    std::atomic<std::uint64_t> min_value;
+
+    /// Largest sample.
+    std::atomic<std::uint64_t> max_recorded;
+
+    /// Number of samples per bucket.
+    std::array<std::atomic<std::uint64_t>, num_buckets> counts;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//------------------------------[ Constructor ]-------------------------------//
+
+inline LatencyHistogram::LatencyHistogram() noexcept:
+    total_count {0},
+    total_sum {0},
+    min_value {std::numeric_limits<std::uint64_t>::max()},
+    max_recorded {0},
+    counts {}
+{
+    for(auto& counter : counts)
+        counter.store(0, std::memory_order_relaxed);
+}
+
+//-------------------------------[ Recording ]--------------------------------//
+
+inline void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+    for(std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+        const auto value = other.counts[bucket].load(std::memory_order_relaxed);
+        if(value != 0)
+            add(counts[bucket], value);
+    }
+    add(total_count, other.total_count.load(std::memory_order_relaxed));
+    add(total_sum, other.total_sum.load(std::memory_order_relaxed));
+
+    const auto other_min = other.min_value.load(std::memory_order_relaxed);
+    if(other_min < min_value.load(std::memory_order_relaxed))
+        min_value.store(other_min, std::memory_order_relaxed);
+    const auto other_max = other.max_recorded.load(std::memory_order_relaxed);
+    if(other_max > max_recorded.load(std::memory_order_relaxed))
+        max_recorded.store(other_max, std::memory_order_relaxed);
+}
+
+inline void LatencyHistogram::clear() noexcept {
+    for(auto& counter : counts)
+        counter.store(0, std::memory_order_relaxed);
+    total_count.store(0, std::memory_order_relaxed);
+    total_sum.store(0, std::memory_order_relaxed);
+    min_value.store(std::numeric_limits<std::uint64_t>::max(),
+                    std::memory_order_relaxed);
+    max_recorded.store(0, std::memory_order_relaxed);
+}
+
+//--------------------------------[ Queries ]---------------------------------//
+
+inline std::chrono::nanoseconds LatencyHistogram::min() const noexcept {
+    const auto value = min_value.load(std::memory_order_relaxed);
+    if(value == std::numeric_limits<std::uint64_t>::max())
+        return std::chrono::nanoseconds {0};
+    return std::chrono::nanoseconds {static_cast<std::int64_t>(value)};
+}
+
+inline std::chrono::nanoseconds LatencyHistogram::mean() const noexcept {
+    const auto samples = count();
+    if(samples == 0)
+        return std::chrono::nanoseconds {0};
+    return std::chrono::nanoseconds {static_cast<std::int64_t>(
+        total_sum.load(std::memory_order_relaxed) / samples)};
+}
+
+inline std::chrono::nanoseconds
+LatencyHistogram::valueAtPercentile(double percentile) const noexcept {
+    const auto samples = count();
+    if(samples == 0)
+        return std::chrono::nanoseconds {0};
+
+    if(percentile < 0.0)
+        percentile = 0.0;
+    if(percentile > 100.0)
+        percentile = 100.0;
+
+    // Rank of the sample, from 1 to the number of samples.
+    auto rank = static_cast<std::uint64_t>(
+        percentile / 100.0 * static_cast<double>(samples) + 0.5);
+    if(rank < 1)
+        rank = 1;
+
+    const auto largest = max_recorded.load(std::memory_order_relaxed);
+    std::uint64_t seen = 0;
+    for(std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+        seen += counts[bucket].load(std::memory_order_relaxed);
+        if(seen >= rank) {
+            const auto value = highestOf(bucket);
+            return std::chrono::nanoseconds {static_cast<std::int64_t>(
+                value < largest? value : largest)};
+        }
+    }
+    return max();
+}
+
+inline std::uint64_t
+LatencyHistogram::countAt(std::chrono::nanoseconds value) const noexcept {
+    return counts[bucketOf(static_cast<std::uint64_t>(
+        value.count() > 0? value.count() : 0))].load(
+            std::memory_order_relaxed);
+}
+
+inline void LatencyHistogram::printSummary(std::ostream& output) const {
+    output
+    << "count: " << count()
+    << ", mean: " << mean()
+    << ", p50: " << valueAtPercentile(50.0)
+    << ", p90: " << valueAtPercentile(90.0)
+    << ", p99: " << valueAtPercentile(99.0)
+    << ", p99.9: " << valueAtPercentile(99.9)
+    << ", max: " << max()
+    << '\n';
+}
+
+//-----------------------------[ Serialization ]------------------------------//
+
+inline void LatencyHistogram::serialize(std::ostream& output) const {
+    std::size_t non_empty = 0;
+    for(const auto& counter : counts)
+        if(counter.load(std::memory_order_relaxed) != 0)
+            ++non_empty;
+
+    // Header: format, layout, and totals; then "bucket count" lines.
+    output
+    << "cea::LatencyHistogram 1 " << sub_bucket_bits << ' ' << max_value_bits
+    << '\n'
+    << count() << ' '
+    << total_sum.load(std::memory_order_relaxed) << ' '
+    << min_value.load(std::memory_order_relaxed) << ' '
+    << max_recorded.load(std::memory_order_relaxed) << ' '
+    << non_empty << '\n';
+    for(std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+        const auto value = counts[bucket].load(std::memory_order_relaxed);
+        if(value != 0)
+            output << bucket << ' ' << value << '\n';
+    }
+}
+
+inline bool LatencyHistogram::deserialize(std::istream& input) {
+    clear();
+
+    std::string magic;
+    unsigned version = 0, bits = 0, value_bits = 0;
+    input >> magic >> version >> bits >> value_bits;
+    if(!input || magic != "cea::LatencyHistogram" || version != 1 ||
+       bits != sub_bucket_bits || value_bits != max_value_bits)
+        return false;
+
+    std::uint64_t samples = 0, sum = 0, smallest = 0, largest = 0;
+    std::size_t non_empty = 0;
+    input >> samples >> sum >> smallest >> largest >> non_empty;
+    if(!input || non_empty > num_buckets)
+        return false;
+
+    std::uint64_t seen = 0;
+    for(std::size_t i = 0; i < non_empty; ++i) {
+        std::size_t bucket = 0;
+        std::uint64_t value = 0;
+        input >> bucket >> value;
+        if(!input || bucket >= num_buckets) {
+            clear();
+            return false;
+        }
+        add(counts[bucket], value);
+        seen += value;
+    }
+    if(seen != samples) {
+        clear();
+        return false;
+    }
+
+    total_count.store(samples, std::memory_order_relaxed);
+    total_sum.store(sum, std::memory_order_relaxed);
+    min_value.store(smallest, std::memory_order_relaxed);
+    max_recorded.store(largest, std::memory_order_relaxed);
+    return true;
+}
+
+} // end of namespace cea
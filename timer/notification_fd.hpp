@@ -0,0 +1,143 @@
+/******************************************************************************
+ * @file notification_fd.hpp
+ * @brief Interface for the NotificationFd class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#if defined(__linux__)
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+    /// Defined when file descriptor notifications are available.
+    #define CEA_TIMER_HAS_NOTIFICATION_FD 1
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define CEA_TIMER_HAS_NOTIFICATION_FD 1
+#endif
+
+#include <cstdint>
+
+namespace cea {
+
+/**
+ * \brief NotificationFd class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A file descriptor that becomes readable when notified, so that event loops
+ * blocked in `poll()`, `epoll_wait()`, or `select()` can wait for it along
+ * with their other descriptors. It is an eventfd on Linux and a non-blocking
+ * pipe on other POSIX systems. On other systems, `open()` fails and the
+ * descriptor is -1.
+ *
+ * The descriptor stays readable until drained, so late pollers still see the
+ * notification. `notify()` only calls `write()`, so it is async-signal-safe.
+ */
+class NotificationFd {
+public:
+    /** \name Constructor and destructor */
+    //@{
+    NotificationFd() = default;
+    NotificationFd(const NotificationFd&) = delete;
+    NotificationFd& operator=(const NotificationFd&) = delete;
+    ~NotificationFd() { close(); }
+    //@}
+
+    /// Open the descriptor. Return false if unsupported or on failure.
+    bool open() noexcept;
+
+    /// Close the descriptor.
+    void close() noexcept;
+
+    /// Make the descriptor readable. Async-signal-safe.
+    void notify() const noexcept;
+
+    /// Consume all pending notifications, making the descriptor unreadable.
+    void drain() const noexcept;
+
+    /// Return the descriptor to wait on, or -1 if not open.
+    int fd() const noexcept {
+        return read_fd;
+    }
+
+    /// Return true if the descriptor is open.
+    bool isOpen() const noexcept {
+        return read_fd != -1;
+    }
+
+private:
+    /// Read side, to be polled.
+    int read_fd {-1};
+
+    /// Write side (the same descriptor for eventfd).
+    int write_fd {-1};
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+inline bool NotificationFd::open() noexcept {
+    if(isOpen())
+        return true;
+
+    #if defined(__linux__)
+    read_fd = write_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return read_fd != -1;
+
+    #elif defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    int fds[2];
+    if(::pipe(fds) != 0)
+        return false;
+    for(const int fd : fds) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    read_fd = fds[0];
+    write_fd = fds[1];
+    return true;
+
+    #else
+    return false;
+    #endif
+}
+
+inline void NotificationFd::close() noexcept {
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    if(write_fd != -1 && write_fd != read_fd)
+        ::close(write_fd);
+    if(read_fd != -1)
+        ::close(read_fd);
+    #endif
+    read_fd = write_fd = -1;
+}
+
+inline void NotificationFd::notify() const noexcept {
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    if(write_fd == -1)
+        return;
+    // eventfd requires 8 bytes; a pipe just needs some byte. A full pipe
+    // (EAGAIN) is already readable, so the result can be ignored.
+    const std::uint64_t one = 1;
+    [[maybe_unused]] const auto written = ::write(write_fd, &one, sizeof(one));
+    #endif
+}
+
+inline void NotificationFd::drain() const noexcept {
+    #if defined(CEA_TIMER_HAS_NOTIFICATION_FD)
+    if(read_fd == -1)
+        return;
+    std::uint64_t buffer[8];
+    while(::read(read_fd, buffer, sizeof(buffer)) > 0) {}
+    #endif
+}
+
+} // end of namespace cea
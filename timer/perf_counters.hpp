@@ -0,0 +1,567 @@
+/******************************************************************************
+ * @file perf_counters.hpp
+ * @brief Interface for the PerfCounters and PerfTimer classes.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/timer.hpp"
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+    #include <linux/perf_event.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    /// Defined when perf_event_open() can be used.
+    #define CEA_TIMER_HAS_PERF_EVENTS 1
+
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+        /// Defined when counters can be read in user space with rdpmc.
+        #define CEA_TIMER_HAS_RDPMC 1
+    #endif
+#endif
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
+namespace cea {
+
+/// What a PerfCounters group counts.
+enum class PerfMode {
+    /// Nothing: perf is not available or not allowed.
+    off,
+
+    /// Software events: task clock, page faults, context switches, and CPU
+    /// migrations. Used when hardware counters are not available, e.g., in
+    /// most virtual machines.
+    software,
+
+    /// Hardware events: cycles, instructions, cache misses, and branch
+    /// misses.
+    hardware
+};
+
+/**
+ * \brief PerfCounts class.
+ *
+ * The values of the events of a PerfCounters group, either totals or the
+ * counts of a region (the difference of two readings). What each value
+ * means depends on the mode; use the accessors of that mode.
+ */
+struct PerfCounts {
+    /// Number of events in a group.
+    static constexpr std::size_t num_events = 4;
+
+    /// The events counted.
+    PerfMode mode {PerfMode::off};
+
+    /// The counts, in the order of the accessors below.
+    std::array<std::uint64_t, num_events> values {};
+
+    /** \name Hardware mode */
+    //@{
+    std::uint64_t cycles() const noexcept { return values[0]; }
+    std::uint64_t instructions() const noexcept { return values[1]; }
+    std::uint64_t cacheMisses() const noexcept { return values[2]; }
+    std::uint64_t branchMisses() const noexcept { return values[3]; }
+
+    /// Instructions per cycle, or zero without cycles.
+    double ipc() const noexcept {
+        return cycles() == 0? 0.0 :
+            static_cast<double>(instructions()) /
+            static_cast<double>(cycles());
+    }
+    //@}
+
+    /** \name Software mode */
+    //@{
+    std::chrono::nanoseconds taskClock() const noexcept {
+        return std::chrono::nanoseconds {
+            static_cast<std::int64_t>(values[0])};
+    }
+    std::uint64_t pageFaults() const noexcept { return values[1]; }
+    std::uint64_t contextSwitches() const noexcept { return values[2]; }
+    std::uint64_t cpuMigrations() const noexcept { return values[3]; }
+    //@}
+
+    /// Return the counts between two readings.
+    PerfCounts operator-(const PerfCounts& before) const noexcept {
+        PerfCounts difference {mode, {}};
+        for(std::size_t i = 0; i < num_events; ++i)
+            difference.values[i] = values[i] - before.values[i];
+        return difference;
+    }
+
+    /// Add the counts of another region.
+    PerfCounts& operator+=(const PerfCounts& other) noexcept {
+        mode = other.mode;
+        for(std::size_t i = 0; i < num_events; ++i)
+            values[i] += other.values[i];
+        return *this;
+    }
+
+    /**
+     * \brief Print the counts in a single line.
+     * \param operations if not zero, also print the counts per operation
+     *        (e.g., per iteration of the measured loop).
+     */
+    void print(std::ostream& output, std::uint64_t operations = 0) const;
+};
+
+/**
+ * \brief PerfCounters class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A group of `perf_event_open()` counters of the calling thread. The group
+ * is opened in the first mode that works:
+ *
+ * - hardware: cycles, instructions, cache misses, and branch misses, read
+ *   in user space with `rdpmc` when the kernel allows it (x86), or with a
+ *   single `read()` of the whole group otherwise;
+ * - software: task clock, page faults, context switches, and CPU
+ *   migrations, when the hardware counters are not available (most
+ *   virtual machines) or not allowed;
+ * - off: when perf is restricted (`perf_event_paranoid` above 2, seccomp)
+ *   or not on Linux. read() then returns zeros, so code using the counters
+ *   keeps working.
+ *
+ * Hardware events are counted in user space only, which
+ * `perf_event_paranoid` 2 (the usual default) allows without privileges.
+ *
+ * The counters only count the thread that opened them, and must be read
+ * from it. forThread() keeps one group per thread.
+ */
+class PerfCounters {
+public:
+    /** \name Constructor and destructor */
+    //@{
+    /// Open the counters of the calling thread.
+    PerfCounters() noexcept;
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// Close the counters.
+    ~PerfCounters();
+    //@}
+
+    /// Return the counters of the calling thread, opening them on first use.
+    static PerfCounters& forThread() noexcept {
+        thread_local PerfCounters counters;
+        return counters;
+    }
+
+    /// Return what the counters count.
+    PerfMode mode() const noexcept { return group_mode; }
+
+    /// Return true if the counters are read in user space with rdpmc.
+    bool usesRdpmc() const noexcept { return use_rdpmc; }
+
+    /// Return the totals since the counters were opened.
+    PerfCounts read() const noexcept;
+
+protected:
+    #if defined(CEA_TIMER_HAS_PERF_EVENTS)
+    /// An event: perf type and config.
+    struct Event {
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    /**
+     * \brief Open a group of events.
+     * \param user_only count only while in user space.
+     * \return false, with nothing open, on failure.
+     */
+    bool open(const std::array<Event, PerfCounts::num_events>& events,
+              bool user_only) noexcept;
+
+    /// Map the first page of each counter, to read them with rdpmc.
+    bool mapForRdpmc() noexcept;
+
+    /// Read all counters with rdpmc. Return false if one is not on a PMC
+    /// at the moment (e.g., multiplexed out).
+    bool readRdpmc(PerfCounts& counts) const noexcept;
+
+    /// Read all counters with a single read() of the group.
+    bool readGroup(PerfCounts& counts) const noexcept;
+
+    /// Close everything.
+    void close() noexcept;
+    #endif
+
+    /** \name Data members */
+    //@{
+    /// What the group counts.
+    PerfMode group_mode;
+
+    /// Whether counters are read with rdpmc.
+    bool use_rdpmc;
+
+    /// File descriptors of the events; the first is the group leader.
+    std::array<int, PerfCounts::num_events> fds;
+
+    /// Mapped pages of the events, for rdpmc.
+    std::array<void*, PerfCounts::num_events> pages;
+    //@}
+};
+
+/**
+ * \brief PerfTimer class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A Timer that also attributes the perf counters of the calling thread to
+ * the time it measures, between starts and stops:
+ *
+ * \code
+ *     cea::PerfTimer timer;
+ *     timer.start();
+ *     for(std::size_t i = 0; i < n; ++i)
+ *         kernel(i);
+ *     timer.stop();
+ *     timer.print(std::cout, n);
+ *     // 12.402 ms, cycles: 41.2M, instructions: 98.6M, IPC: 2.39,
+ *     // cache misses: 0.84/op, branch misses: 0.02/op
+ * \endcode
+ *
+ * It must be used by a single thread, since the counters only count the
+ * thread that reads them.
+ */
+class PerfTimer {
+public:
+    /** \name Constructor */
+    //@{
+    /// Default Constructor.
+    PerfTimer() noexcept:
+        counters {PerfCounters::forThread()},
+        timer {},
+        start_counts {},
+        accumulated {counters.mode(), {}}
+    {}
+    //@}
+
+    /** Timer manipulation */
+    //@{
+    /// Start the timer and the counting. It also works as a reset.
+    void start() noexcept {
+        accumulated = PerfCounts {counters.mode(), {}};
+        timer.start();
+        start_counts = counters.read();
+    }
+
+    /// Stop the timer and the counting.
+    void stop() noexcept {
+        if(timer.isStopped())
+            return;
+        accumulated += counters.read() - start_counts;
+        timer.stop();
+    }
+
+    /// Resume the timer and the counting.
+    void resume() noexcept {
+        if(!timer.isStopped())
+            return;
+        timer.resume();
+        start_counts = counters.read();
+    }
+    //@}
+
+    /** Time and counts retrieval */
+    //@{
+    /// Return the elapsed time between starts and stops in nanoseconds.
+    std::chrono::nanoseconds elapsedInNanoseconds() const noexcept {
+        return timer.elapsedInNanoseconds();
+    }
+
+    /// Return the elapsed time between starts and stops in seconds.
+    std::chrono::seconds elapsed() const noexcept {
+        return timer.elapsed();
+    }
+
+    /// Return the counts between starts and stops.
+    PerfCounts counts() const noexcept {
+        auto total = accumulated;
+        if(!timer.isStopped())
+            total += counters.read() - start_counts;
+        return total;
+    }
+
+    /// Return true if the timer has been stopped.
+    bool isStopped() const noexcept {
+        return timer.isStopped();
+    }
+
+    /// Print the elapsed time and the counts, per operation if not zero.
+    void print(std::ostream& output, std::uint64_t operations = 0) const;
+    //@}
+
+protected:
+    /** \name Data members */
+    //@{
+    /// The counters of the thread.
+    const PerfCounters& counters;
+
+    /// Measures the wall time.
+    Timer timer;
+
+    /// The counters at the last start or resume.
+    PerfCounts start_counts;
+
+    /// Counts between the previous starts and stops.
+    PerfCounts accumulated;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//-------------------------------[ PerfCounts ]-------------------------------//
+
+inline void PerfCounts::print(std::ostream& output,
+                              std::uint64_t operations) const {
+    // Large counts in millions, small ones as they are.
+    const auto count = [&output](std::uint64_t value) -> std::ostream& {
+        if(value >= 10'000'000)
+            return output << std::setprecision(1)
+                          << static_cast<double>(value) / 1e6 << "M";
+        return output << value;
+    };
+    const auto perOperation = [&](const char* name, std::uint64_t value) {
+        output << ", " << name << ": ";
+        if(operations == 0)
+            count(value);
+        else
+            output << std::setprecision(2)
+                   << static_cast<double>(value) /
+                      static_cast<double>(operations) << "/op";
+    };
+
+    output << std::fixed;
+    switch(mode) {
+    case PerfMode::hardware:
+        output << "cycles: ";
+        count(cycles()) << ", instructions: ";
+        count(instructions())
+            << ", IPC: " << std::setprecision(2) << ipc();
+        perOperation("cache misses", cacheMisses());
+        perOperation("branch misses", branchMisses());
+        break;
+
+    case PerfMode::software:
+        output
+        << "task clock: " << std::setprecision(3)
+        << std::chrono::duration<double, std::milli>(taskClock()).count()
+        << " ms";
+        perOperation("page faults", pageFaults());
+        perOperation("context switches", contextSwitches());
+        perOperation("migrations", cpuMigrations());
+        break;
+
+    case PerfMode::off:
+        output << "perf counters not available";
+        break;
+    }
+    output << '\n';
+}
+
+//------------------------------[ PerfCounters ]------------------------------//
+
+#if defined(CEA_TIMER_HAS_PERF_EVENTS)
+
+inline PerfCounters::PerfCounters() noexcept:
+    group_mode {PerfMode::off},
+    use_rdpmc {false},
+    fds {-1, -1, -1, -1},
+    pages {nullptr, nullptr, nullptr, nullptr}
+{
+    static constexpr std::array<Event, PerfCounts::num_events> hardware {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}
+    }};
+    static constexpr std::array<Event, PerfCounts::num_events> software {{
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS}
+    }};
+
+    // Context switches and migrations happen in the kernel, so software
+    // events are counted there too, if allowed.
+    if(open(hardware, true)) {
+        group_mode = PerfMode::hardware;
+        use_rdpmc = mapForRdpmc();
+    }
+    else if(open(software, false) || open(software, true)) {
+        group_mode = PerfMode::software;
+    }
+}
+
+inline PerfCounters::~PerfCounters() {
+    close();
+}
+
+inline bool PerfCounters::open(
+    const std::array<Event, PerfCounts::num_events>& events,
+    bool user_only) noexcept
+{
+    for(std::size_t i = 0; i < events.size(); ++i) {
+        perf_event_attr attributes {};
+        attributes.size = sizeof(attributes);
+        attributes.type = events[i].type;
+        attributes.config = events[i].config;
+        attributes.read_format = PERF_FORMAT_GROUP;
+        attributes.exclude_kernel = user_only? 1 : 0;
+        attributes.exclude_hv = 1;
+
+        const auto fd = ::syscall(SYS_perf_event_open, &attributes,
+                                  0,                   // This thread,
+                                  -1,                  // on any CPU.
+                                  i == 0? -1 : fds[0], // Group leader.
+                                  PERF_FLAG_FD_CLOEXEC);
+        if(fd < 0) {
+            close();
+            return false;
+        }
+        fds[i] = static_cast<int>(fd);
+    }
+    return true;
+}
+
+inline bool PerfCounters::mapForRdpmc() noexcept {
+    #if defined(CEA_TIMER_HAS_RDPMC)
+    const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    for(std::size_t i = 0; i < fds.size(); ++i) {
+        void* page = ::mmap(nullptr, page_size, PROT_READ, MAP_SHARED,
+                            fds[i], 0);
+        if(page == MAP_FAILED)
+            return false;
+        pages[i] = page;
+        if(!static_cast<perf_event_mmap_page*>(page)->cap_user_rdpmc)
+            return false;
+    }
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+inline PerfCounts PerfCounters::read() const noexcept {
+    PerfCounts counts {group_mode, {}};
+    if(group_mode == PerfMode::off)
+        return counts;
+    if(use_rdpmc && readRdpmc(counts))
+        return counts;
+    readGroup(counts);
+    return counts;
+}
+
+inline bool PerfCounters::readRdpmc(PerfCounts& counts) const noexcept {
+    #if defined(CEA_TIMER_HAS_RDPMC)
+    for(std::size_t i = 0; i < fds.size(); ++i) {
+        const auto* page = static_cast<volatile perf_event_mmap_page*>(
+            pages[i]);
+        std::uint32_t sequence, index;
+        std::uint64_t value;
+        // The kernel bumps `lock` around updates, like a seqlock.
+        do {
+            sequence = page->lock;
+            std::atomic_signal_fence(std::memory_order_acq_rel);
+            index = page->index;
+            value = static_cast<std::uint64_t>(page->offset);
+            if(index == 0 || page->pmc_width == 0)
+                return false;
+            // Sign-extend the counter from its width.
+            const auto shift = 64 - page->pmc_width;
+            auto pmc = static_cast<std::int64_t>(
+                static_cast<std::uint64_t>(__rdpmc(
+                    static_cast<int>(index - 1))) << shift);
+            value += static_cast<std::uint64_t>(pmc >> shift);
+            std::atomic_signal_fence(std::memory_order_acq_rel);
+        } while(page->lock != sequence);
+        counts.values[i] = value;
+    }
+    return true;
+    #else
+    (void) counts;
+    return false;
+    #endif
+}
+
+inline bool PerfCounters::readGroup(PerfCounts& counts) const noexcept {
+    struct {
+        std::uint64_t size;
+        std::uint64_t values[PerfCounts::num_events];
+    } group {};
+    if(::read(fds[0], &group, sizeof(group)) < 0 ||
+       group.size != PerfCounts::num_events)
+        return false;
+    for(std::size_t i = 0; i < PerfCounts::num_events; ++i)
+        counts.values[i] = group.values[i];
+    return true;
+}
+
+inline void PerfCounters::close() noexcept {
+    const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    for(auto& page : pages) {
+        if(page != nullptr)
+            ::munmap(page, page_size);
+        page = nullptr;
+    }
+    // Members first, then the leader.
+    for(auto fd = fds.rbegin(); fd != fds.rend(); ++fd) {
+        if(*fd >= 0)
+            ::close(*fd);
+        *fd = -1;
+    }
+    use_rdpmc = false;
+}
+
+#else // CEA_TIMER_HAS_PERF_EVENTS
+
+inline PerfCounters::PerfCounters() noexcept:
+    group_mode {PerfMode::off},
+    use_rdpmc {false},
+    fds {-1, -1, -1, -1},
+    pages {nullptr, nullptr, nullptr, nullptr}
+{}
+
+inline PerfCounters::~PerfCounters() {}
+
+inline PerfCounts PerfCounters::read() const noexcept {
+    return PerfCounts {};
+}
+
+#endif // CEA_TIMER_HAS_PERF_EVENTS
+
+//-------------------------------[ PerfTimer ]--------------------------------//
+
+inline void PerfTimer::print(std::ostream& output,
+                             std::uint64_t operations) const {
+    output
+    << std::fixed << std::setprecision(3)
+    << std::chrono::duration<double, std::milli>(elapsedInNanoseconds())
+           .count()
+    << " ms, ";
+    counts().print(output, operations);
+}
+
+} // end of namespace cea
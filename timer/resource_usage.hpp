@@ -0,0 +1,233 @@
+/******************************************************************************
+ * @file resource_usage.hpp
+ * @brief Interface for the ResourceUsage and UsageMeter classes.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/clocks.hpp"
+#include "timer/timer.hpp"
+
+#if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+    #include <sys/resource.h>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <thread>
+
+namespace cea {
+
+#if defined(CEA_TIMER_HAS_POSIX_CLOCKS)
+
+/// A timer measuring the CPU time of the calling thread.
+using ThreadCpuTimer = BasicTimer<ThreadCpuClock>;
+
+/// A timer measuring the CPU time of the whole process.
+using ProcessCpuTimer = BasicTimer<ProcessCpuClock>;
+
+/**
+ * \brief ResourceUsage class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A snapshot of `getrusage()`: user and system CPU time, and context
+ * switches. Snapshots are subtracted to get the usage of a region.
+ *
+ * Voluntary context switches happen when a thread blocks (on I/O, a lock, a
+ * sleep); involuntary ones, when it is preempted, which hints at more busy
+ * threads than cores. The kernel accounts the CPU times at tick granularity
+ * (usually 1 to 4 ms), so they are meant for regions of tens of milliseconds
+ * or more; use ThreadCpuClock or ProcessCpuClock for shorter ones.
+ */
+struct ResourceUsage {
+    /// CPU time spent in user mode.
+    std::chrono::nanoseconds user {0};
+
+    /// CPU time spent in the kernel on behalf of the process or thread.
+    std::chrono::nanoseconds system {0};
+
+    /// Context switches due to blocking.
+    std::int64_t voluntary_switches {0};
+
+    /// Context switches due to preemption.
+    std::int64_t involuntary_switches {0};
+
+    /// Return the usage of the whole process so far.
+    static ResourceUsage ofProcess() noexcept {
+        return query(RUSAGE_SELF);
+    }
+
+    /// Return the usage of the calling thread so far.
+    static ResourceUsage ofThread() noexcept {
+        return query(RUSAGE_THREAD);
+    }
+
+    /// Return the usage between two snapshots.
+    ResourceUsage operator-(const ResourceUsage& before) const noexcept {
+        return {user - before.user, system - before.system,
+                voluntary_switches - before.voluntary_switches,
+                involuntary_switches - before.involuntary_switches};
+    }
+
+protected:
+    /// Call getrusage() for `who`. Return zeros on failure.
+    static ResourceUsage query(int who) noexcept {
+        rusage usage {};
+        if(getrusage(who, &usage) != 0)
+            return {};
+        const auto toNanoseconds = [](const timeval& time) {
+            return std::chrono::seconds {time.tv_sec} +
+                   std::chrono::microseconds {time.tv_usec};
+        };
+        return {toNanoseconds(usage.ru_utime), toNanoseconds(usage.ru_stime),
+                static_cast<std::int64_t>(usage.ru_nvcsw),
+                static_cast<std::int64_t>(usage.ru_nivcsw)};
+    }
+};
+
+/**
+ * \brief UsageReport class.
+ *
+ * The wall time, CPU time, and resource usage of a region, as measured by
+ * UsageMeter.
+ */
+struct UsageReport {
+    /// Wall-clock time.
+    std::chrono::nanoseconds wall {0};
+
+    /// CPU time of the process, all threads together.
+    std::chrono::nanoseconds cpu {0};
+
+    /// User/system times and context switches of the process.
+    ResourceUsage usage {};
+
+    /**
+     * \brief Return the average number of busy cores: CPU time over wall
+     *        time.
+     *
+     * About 1 for a single busy thread, about N for N busy threads, and well
+     * below the number of threads when they block or are oversubscribed.
+     */
+    double cpuUtilization() const noexcept {
+        return wall.count() <= 0? 0.0 :
+            static_cast<double>(cpu.count()) /
+            static_cast<double>(wall.count());
+    }
+
+    /**
+     * \brief Return the parallel efficiency: the fraction of the wall time
+     *        that `num_threads` threads kept their cores busy.
+     *
+     * 1 means every thread computed all the time; lower values mean time
+     * spent blocked, waiting for a core, or idle at the end of the region.
+     */
+    double parallelEfficiency(unsigned num_threads) const noexcept {
+        return num_threads == 0? 0.0 : cpuUtilization() / num_threads;
+    }
+
+    /// Print the report in a single line.
+    void print(std::ostream& output, unsigned num_threads =
+                   std::thread::hardware_concurrency()) const;
+};
+
+/**
+ * \brief UsageMeter class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Measures the wall time, the CPU time of the process, and the resource
+ * usage of a region together, to tell whether it was CPU-bound, blocked, or
+ * oversubscribed:
+ *
+ * \code
+ *     cea::UsageMeter meter;
+ *     meter.start();
+ *     runParallelPhase(num_threads);
+ *     const auto report = meter.report();
+ *     report.print(std::cout, num_threads);
+ *     // wall: 2.013 s, cpu: 7.644 s, user: 7.601 s, sys: 0.042 s,
+ *     // busy cores: 3.80, efficiency: 94.9%, switches: 12 vol., 85 invol.
+ * \endcode
+ *
+ * The CPU time is the process's, so the region should be the only work
+ * running in the process for the numbers to be meaningful.
+ */
+class UsageMeter {
+public:
+    /** \name Constructor */
+    //@{
+    /// Build a meter, already measuring.
+    UsageMeter() noexcept:
+        wall_start {std::chrono::steady_clock::now()},
+        cpu_start {ProcessCpuClock::now()},
+        usage_start {ResourceUsage::ofProcess()}
+    {}
+    //@}
+
+    /// Start measuring. It also works as a reset.
+    void start() noexcept {
+        wall_start = std::chrono::steady_clock::now();
+        cpu_start = ProcessCpuClock::now();
+        usage_start = ResourceUsage::ofProcess();
+    }
+
+    /// Return the usage since the last start. The meter keeps running.
+    UsageReport report() const noexcept {
+        return {std::chrono::steady_clock::now() - wall_start,
+                ProcessCpuClock::now() - cpu_start,
+                ResourceUsage::ofProcess() - usage_start};
+    }
+
+protected:
+    /** \name Data members */
+    //@{
+    /// Wall-clock time at the last start.
+    std::chrono::steady_clock::time_point wall_start;
+
+    /// CPU time of the process at the last start.
+    ProcessCpuClock::time_point cpu_start;
+
+    /// Resource usage of the process at the last start.
+    ResourceUsage usage_start;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+inline void UsageReport::print(std::ostream& output,
+                               unsigned num_threads) const {
+    const auto toSeconds = [](std::chrono::nanoseconds time) {
+        return std::chrono::duration<double>(time).count();
+    };
+
+    output
+    << std::fixed << std::setprecision(3)
+    << "wall: " << toSeconds(wall) << " s"
+    << ", cpu: " << toSeconds(cpu) << " s"
+    << ", user: " << toSeconds(usage.user) << " s"
+    << ", sys: " << toSeconds(usage.system) << " s"
+    << std::setprecision(2)
+    << ", busy cores: " << cpuUtilization()
+    << std::setprecision(1)
+    << ", efficiency: " << 100.0 * parallelEfficiency(num_threads) << "%"
+    << ", switches: " << usage.voluntary_switches << " vol., "
+    << usage.involuntary_switches << " invol."
+    << '\n';
+}
+
+#endif // CEA_TIMER_HAS_POSIX_CLOCKS
+
+} // end of namespace cea
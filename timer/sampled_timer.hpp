@@ -0,0 +1,383 @@
+/******************************************************************************
+ * @file sampled_timer.hpp
+ * @brief Interface for the BasicSampledTimer class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/clock_calibration.hpp"
+#include "timer/clocks.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
+namespace cea {
+
+/**
+ * \brief SampledEstimate class.
+ *
+ * The time of all calls to a region, estimated from the sampled ones.
+ * Estimates of independent timers (e.g., one per thread) are added with
+ * `+=`, whatever their sampling periods.
+ */
+struct SampledEstimate {
+    /// Calls to the region, sampled or not.
+    std::uint64_t calls {0};
+
+    /// Calls that were timed.
+    std::uint64_t samples {0};
+
+    /// Estimated time of all calls, in nanoseconds.
+    double total {0.0};
+
+    /// Variance of `total`, in squared nanoseconds.
+    double variance {0.0};
+
+    /// Return the estimated mean time per call.
+    std::chrono::nanoseconds mean() const noexcept {
+        return std::chrono::nanoseconds {calls == 0? 0 :
+            std::llround(total / static_cast<double>(calls))};
+    }
+
+    /// Return the estimated time of all calls.
+    std::chrono::nanoseconds totalTime() const noexcept {
+        return std::chrono::nanoseconds {std::llround(total)};
+    }
+
+    /**
+     * \brief Return the half-width of the confidence interval of the total
+     *        time, from the standard error of the sample mean.
+     * \param z standard normal quantile of the confidence level; 1.96 for
+     *        95%.
+     */
+    std::chrono::nanoseconds totalError(double z = 1.96) const noexcept {
+        return std::chrono::nanoseconds {std::llround(z * std::sqrt(variance))};
+    }
+
+    /// Add the estimate of an independent timer.
+    SampledEstimate& operator+=(const SampledEstimate& other) noexcept {
+        calls += other.calls;
+        samples += other.samples;
+        total += other.total;
+        variance += other.variance;
+        return *this;
+    }
+
+    /// Print the estimate in a single line.
+    void print(std::ostream& output) const;
+};
+
+/**
+ * \brief BasicSampledTimer class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Times a hot region on only one in `period()` calls, and scales the sampled
+ * times into an estimate of the time of all calls, with an error bound:
+ *
+ * \code
+ *     thread_local cea::SampledTimer timer;
+ *
+ *     void lookup(Key key) {
+ *         const auto sample = timer.measure();
+ *         // ...
+ *     }
+ *     // Later, in the same thread:
+ *     timer.estimate().print(std::cout);
+ *     // calls: 412003328, samples: 402347 (1 in 1024), mean: 11ns,
+ *     // total: 4.532 s +- 0.21%
+ * \endcode
+ *
+ * A call that is not sampled costs a counter increment and a countdown, with
+ * no clock read. The countdown is reset to a random value averaging the
+ * period, so calls that alternate between fast and slow paths are not
+ * sampled always on the same path.
+ *
+ * With `Period` greater than zero, the period is fixed at compile time.
+ * With `Period` zero (the default), it is adapted at runtime to an overhead
+ * budget: the cost of the two clock reads of a sample (from
+ * ClockCalibration) over the period times the mean call time is kept below
+ * the given fraction.
+ *
+ * Samples taken by measure() are corrected by the timer bias of the clock
+ * (see ClockCalibration), so regions of a few nanoseconds are not swamped
+ * by the clock reads around them. The total is estimated as the number of
+ * calls times the mean of the samples. Its error comes from the variance of
+ * the samples, with the finite population correction, so it shrinks as
+ * samples accumulate. The estimate is only unbiased if the timer is used
+ * often enough to be sampled: a region called a few times per period may
+ * not be sampled at all.
+ *
+ * Like LatencyHistogram, the timer is single-writer: use one per thread
+ * (e.g., `thread_local`) and add their estimates. The counters are relaxed
+ * atomics, so other threads can read the estimate while it is recorded.
+ *
+ * \tparam Clock the clock policy used to time the samples (see BasicTimer).
+ * \tparam Period the fixed sampling period, or zero for an adaptive one.
+ */
+template <class Clock = TscClock, std::uint64_t Period = 0>
+class BasicSampledTimer {
+public:
+    /// The clock policy used by this timer.
+    using clock = Clock;
+
+    /// Whether the period adapts to an overhead budget.
+    static constexpr bool is_adaptive = Period == 0;
+
+    /// The largest adaptive period.
+    static constexpr std::uint64_t max_period = std::uint64_t {1} << 20;
+
+    /**
+     * \brief Sample class.
+     *
+     * Times the scope it lives in, if its call was sampled.
+     */
+    class Sample {
+    public:
+        /** \name Constructor and destructor */
+        //@{
+        /// Enter the region.
+        explicit Sample(BasicSampledTimer& sampled_timer) noexcept:
+            timer {sampled_timer.shouldSample()? &sampled_timer : nullptr},
+            start_time {}
+        {
+            if(timer != nullptr) [[unlikely]]
+                start_time = Clock::now();
+        }
+
+        Sample(const Sample&) = delete;
+        Sample& operator=(const Sample&) = delete;
+
+        /// Leave the region.
+        ~Sample() {
+            if(timer != nullptr) [[unlikely]]
+                timer->record(Clock::now() - start_time - timer->bias);
+        }
+        //@}
+
+    private:
+        /// The timer, if this call is sampled.
+        BasicSampledTimer* const timer;
+
+        /// When the region was entered.
+        typename Clock::time_point start_time;
+    };
+
+    /** \name Constructor */
+    //@{
+    /**
+     * \brief Build a timer.
+     * \param overhead_budget the fraction of the region's time that the
+     *        adaptive sampling may spend reading the clock; ignored with a
+     *        fixed period.
+     */
+    explicit BasicSampledTimer(double overhead_budget = 0.01):
+        budget {std::max(overhead_budget, 1e-9)},
+        sample_cost {2.0 * static_cast<double>(
+            ClockCalibration::of<Clock>().read_overhead.count())},
+        bias {ClockCalibration::of<Clock>().timer_bias},
+        sampling_period {is_adaptive? 1 : Period},
+        countdown {1},
+        random_state {reinterpret_cast<std::uintptr_t>(this) | 1},
+        num_calls {0},
+        num_samples {0},
+        sum {0},
+        sum_squares {0.0}
+    {
+        static_assert(Period == 0 || Period <= max_period,
+                      "The sampling period is too large");
+    }
+
+    BasicSampledTimer(const BasicSampledTimer&) = delete;
+    BasicSampledTimer& operator=(const BasicSampledTimer&) = delete;
+    //@}
+
+    /** Recording (single writer) */
+    //@{
+    /// Enter the region; it is left when the returned object is destroyed.
+    [[nodiscard]] Sample measure() noexcept {
+        return Sample {*this};
+    }
+
+    /**
+     * \brief Count a call and tell whether to time it.
+     *
+     * For regions that do not fit a scope: if true, time the call and pass
+     * its duration to record().
+     */
+    bool shouldSample() noexcept {
+        add(num_calls, std::uint64_t {1});
+        if(--countdown != 0) [[likely]]
+            return false;
+        countdown = nextCountdown();
+        return true;
+    }
+
+    /// Record the duration of a sampled call. Negative ones count as zero.
+    template <class Rep, class Ratio>
+    void record(std::chrono::duration<Rep, Ratio> elapsed) noexcept {
+        const auto time = std::max<std::int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count(), 0);
+        add(num_samples, std::uint64_t {1});
+        add(sum, static_cast<std::uint64_t>(time));
+        add(sum_squares, static_cast<double>(time) *
+                         static_cast<double>(time));
+        if constexpr(is_adaptive)
+            adapt();
+    }
+
+    /// Discard all calls and samples.
+    void reset() noexcept;
+    //@}
+
+    /** Queries (any thread) */
+    //@{
+    /// Return the current sampling period.
+    std::uint64_t period() const noexcept {
+        return sampling_period.load(std::memory_order_relaxed);
+    }
+
+    /// Return the estimate of the time of all calls so far.
+    SampledEstimate estimate() const noexcept;
+    //@}
+
+protected:
+    /// Single-writer increment: no read-modify-write needed.
+    template <class T>
+    static void add(std::atomic<T>& counter, T value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                      std::memory_order_relaxed);
+    }
+
+    /// Return the calls until the next sample: uniform in
+    /// [1, 2 * period - 1], so it averages the period.
+    std::uint64_t nextCountdown() noexcept {
+        const auto period = sampling_period.load(std::memory_order_relaxed);
+        if(period == 1)
+            return 1;
+        // xorshift64.
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        return 1 + random_state % (2 * period - 1);
+    }
+
+    /// Set the period so that the sampled clock reads stay within budget.
+    void adapt() noexcept {
+        const auto samples = num_samples.load(std::memory_order_relaxed);
+        const auto mean = static_cast<double>(
+            sum.load(std::memory_order_relaxed)) /
+            static_cast<double>(samples);
+        // overhead = sample_cost / (period * mean) <= budget.
+        const auto period = mean <= 0.0? static_cast<double>(max_period) :
+                            std::ceil(sample_cost / (budget * mean));
+        sampling_period.store(static_cast<std::uint64_t>(
+            std::clamp(period, 1.0, static_cast<double>(max_period))),
+            std::memory_order_relaxed);
+    }
+
+    /** \name Data members */
+    //@{
+    /// Fraction of the region's time the adaptive sampling may spend.
+    const double budget;
+
+    /// Cost of timing a call (two clock reads), in nanoseconds.
+    const double sample_cost;
+
+    /// Time measured around an empty region, subtracted from each sample.
+    const std::chrono::nanoseconds bias;
+
+    /// One in `sampling_period` calls is timed, on average. Written only by
+    /// the timed thread, like the counters, and read by period().
+    std::atomic<std::uint64_t> sampling_period;
+
+    /// Calls until the next sample.
+    std::uint64_t countdown;
+
+    /// State of the generator of countdowns.
+    std::uint64_t random_state;
+
+    /// Calls so far.
+    std::atomic<std::uint64_t> num_calls;
+
+    /// Sampled calls so far.
+    std::atomic<std::uint64_t> num_samples;
+
+    /// Sum of the sampled times, in nanoseconds.
+    std::atomic<std::uint64_t> sum;
+
+    /// Sum of the squared sampled times.
+    std::atomic<double> sum_squares;
+    //@}
+};
+
+/// Sampled timer with an adaptive period, on TscClock.
+using SampledTimer = BasicSampledTimer<TscClock>;
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+inline void SampledEstimate::print(std::ostream& output) const {
+    const auto seconds = std::chrono::duration<double>(totalTime()).count();
+    output
+    << "calls: " << calls
+    << ", samples: " << samples;
+    if(samples > 0)
+        output << " (1 in " << calls / samples << ")";
+    output
+    << ", mean: " << mean()
+    << ", total: " << std::fixed << std::setprecision(3) << seconds << " s"
+    << " +- " << std::setprecision(2)
+    << (total > 0.0? 100.0 * 1.96 * std::sqrt(variance) / total : 0.0)
+    << "%\n";
+}
+
+template <class Clock, std::uint64_t Period>
+void BasicSampledTimer<Clock, Period>::reset() noexcept {
+    sampling_period.store(is_adaptive? 1 : Period, std::memory_order_relaxed);
+    countdown = 1;
+    num_calls.store(0, std::memory_order_relaxed);
+    num_samples.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    sum_squares.store(0.0, std::memory_order_relaxed);
+}
+
+template <class Clock, std::uint64_t Period>
+SampledEstimate BasicSampledTimer<Clock, Period>::estimate() const noexcept {
+    SampledEstimate result;
+    result.calls = num_calls.load(std::memory_order_relaxed);
+    result.samples = num_samples.load(std::memory_order_relaxed);
+    if(result.samples == 0)
+        return result;
+
+    const auto n = static_cast<double>(result.calls);
+    const auto k = static_cast<double>(result.samples);
+    const auto mean = static_cast<double>(
+        sum.load(std::memory_order_relaxed)) / k;
+    result.total = n * mean;
+    if(result.samples < 2)
+        return result;
+
+    // Variance of n * mean, with the finite population correction.
+    const auto variance = std::max(0.0,
+        (sum_squares.load(std::memory_order_relaxed) - k * mean * mean) /
+        (k - 1.0));
+    result.variance = n * n * variance / k * std::max(0.0, 1.0 - k / n);
+    return result;
+}
+
+} // end of namespace cea
@@ -0,0 +1,505 @@
+/******************************************************************************
+ * @file shared_stopper.hpp
+ * @brief Interface for the SharedStopper class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    /// Defined when memory can be shared between processes.
+    #define CEA_TIMER_HAS_SHARED_MEMORY 1
+#endif
+
+#include "timer/clocks.hpp"
+#include "timer/deadline_service.hpp"
+#include "timer/execution_stopper.hpp"
+#include "timer/stop_scope.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace cea {
+
+/**
+ * \brief SharedStopperState class.
+ *
+ * The state of a SharedStopper, placed in memory shared by the processes.
+ * All zeros is a valid state: not expired, and no deadline.
+ */
+struct SharedStopperState {
+    /// Nonzero once expired. On its own cache line, as it is read by every
+    /// process on every check.
+    alignas(cache_line_size) std::atomic<std::uint32_t> expired {0};
+
+    /// Id of the process that expired the stopper, or 0.
+    std::atomic<std::int32_t> expired_by {0};
+
+    /// Incremented by each reset(), so the watchdog tells runs apart.
+    std::atomic<std::uint32_t> run {0};
+
+    /// The deadline, in `steady_clock` nanoseconds, or 0 for none. The
+    /// steady clock is the system-wide monotonic clock, so every process
+    /// reads the same time.
+    alignas(cache_line_size) std::atomic<std::int64_t> deadline {0};
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+                  std::atomic<std::int64_t>::is_always_lock_free,
+                  "Atomics shared between processes must be lock-free");
+};
+
+/**
+ * \brief SharedStopper class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A stopper whose expired flag and deadline live in memory shared between
+ * processes, so a parent and the workers it forks honor a single deadline
+ * and a single Ctrl-C:
+ *
+ * \code
+ *     cea::SharedStopper shared;
+ *     shared.create();  // Before forking.
+ *     cea::ExecutionStopper::setExpirationTime(std::chrono::seconds {60});
+ *     cea::ExecutionStopper::start();
+ *     shared.bind();    // Expires with the ExecutionStopper, and vice versa.
+ *
+ *     for(int i = 0; i < num_workers; ++i)
+ *         if(::fork() == 0) {
+ *             while(!shared.isExpired())
+ *                 search();
+ *             if(found_optimum)
+ *                 shared.expire();  // Stops everybody.
+ *             ::_exit(0);
+ *         }
+ * \endcode
+ *
+ * isExpired() is a single relaxed load in every process, and any process can
+ * expire() the stopper for all. The memory is either an anonymous mapping,
+ * inherited by the processes forked after create(), a named POSIX
+ * shared-memory segment (`create(name)` and `open(name)`), or a file mapped
+ * by every process (openFile()), for processes that are not forked from
+ * one another.
+ *
+ * After `fork()`, a child has none of the threads of its parent: neither the
+ * DeadlineService watchdog nor the ExecutionStopper signal thread. So the
+ * checks of the children are only on the shared flag, and it is up to a
+ * process with a watchdog to expire it on time: bind() makes the watchdog of
+ * the calling process poll the shared deadline, and tie the shared flag to a
+ * StopScope (by default, the ExecutionStopper), both ways. The expiration of
+ * the scope (deadline, Ctrl-C, budgets) expires the shared flag, and an
+ * expiration by any process expires the scope, within a polling interval.
+ * Ctrl-C reaches the whole process group, and is handled by the parent's
+ * stopper. Processes without a watchdog can call checkDeadline() from time
+ * to time instead. Children should leave with `_exit()`, as the destructors
+ * of the singletons would wait for threads they do not have.
+ */
+class SharedStopper {
+public:
+    /** \name Constructor and destructor */
+    //@{
+    /// Build a stopper that is not shared yet, and never expires.
+    SharedStopper() noexcept:
+        state {&unshared_state},
+        mapped {false},
+        poll {*this},
+        bound {false},
+        bound_scope {nullptr},
+        bound_pid {0},
+        poll_interval {0},
+        bound_run {0},
+        scope_was_expired {false},
+        state_was_expired {false}
+    {}
+
+    SharedStopper(const SharedStopper&) = delete;
+    SharedStopper& operator=(const SharedStopper&) = delete;
+
+    /// Unbind and unmap the memory. Named segments and files are kept.
+    ~SharedStopper() { close(); }
+    //@}
+
+    /** \name Shared memory */
+    //@{
+    /// Map an anonymous segment, shared with the processes forked from now
+    /// on, and reset it. Return false if unsupported or on failure.
+    bool create() noexcept;
+
+    /**
+     * \brief Create, or open, the POSIX shared-memory segment `name`, and
+     *        reset it.
+     * \param name the segment name, starting with a slash, such as
+     *        "/solver_stopper".
+     * \return false if unsupported or on failure.
+     *
+     * The segment outlives the processes; remove it with unlink().
+     */
+    bool create(const char* name) noexcept;
+
+    /// Open the POSIX shared-memory segment `name`, created by another
+    /// process, keeping its state. Return false if it does not exist.
+    bool open(const char* name) noexcept;
+
+    /// Map the file at `path`, creating it if needed, and keeping its state.
+    /// Return false if unsupported or on failure.
+    bool openFile(const char* path) noexcept;
+
+    /// Unbind and unmap the memory; the stopper is then unshared.
+    void close() noexcept;
+
+    /// Remove the shared-memory segment `name`. Mapped stoppers keep it
+    /// until closed.
+    static bool unlink(const char* name) noexcept;
+
+    /// Return true if the memory is mapped.
+    bool isShared() const noexcept {
+        return mapped;
+    }
+    //@}
+
+    /** \name Expiration */
+    //@{
+    /// Return true if any process expired the stopper. A single relaxed
+    /// load.
+    bool isExpired() const noexcept {
+        return state->expired.load(std::memory_order_relaxed) != 0;
+    }
+
+    /// Expire the stopper for all processes.
+    void expire() noexcept;
+
+    /// Return the id of the process that expired the stopper, or 0.
+    int expiredBy() const noexcept {
+        return state->expired_by.load(std::memory_order_relaxed);
+    }
+
+    /// Clear the expiration and the deadline, for a new run.
+    void reset() noexcept;
+    //@}
+
+    /** \name Deadline */
+    //@{
+    /// Set the shared deadline to `expiration_time` from now.
+    void setExpirationTime(std::chrono::nanoseconds expiration_time) noexcept;
+
+    /// Remove the shared deadline.
+    void clearDeadline() noexcept {
+        state->deadline.store(0, std::memory_order_relaxed);
+    }
+
+    /// Return the time left to the shared deadline, or nanoseconds::max()
+    /// if there is none.
+    std::chrono::nanoseconds remaining() const noexcept;
+
+    /// Expire the stopper if its deadline passed, and return isExpired().
+    /// Reads the clock; meant for processes without a bound watchdog.
+    bool checkDeadline() noexcept;
+    //@}
+
+    /** \name Binding */
+    //@{
+    /**
+     * \brief Tie the stopper to `scope` in this process, through the
+     *        watchdog.
+     * \param scope expires the stopper when it expires, and is expired
+     *        when any process expires the stopper.
+     * \param interval how often the watchdog polls the shared state.
+     *
+     * The watchdog also expires the stopper at its deadline. Bind in a
+     * single process, the one with the watchdog (usually the parent).
+     */
+    void bind(StopScope& scope = ExecutionStopper::root(),
+              std::chrono::nanoseconds interval =
+                  std::chrono::milliseconds {1}) noexcept;
+
+    /// Stop polling. Does nothing in a forked child of the bound process.
+    void unbind() noexcept;
+    //@}
+
+protected:
+    /// Polls the shared state from the watchdog.
+    struct Poll: DeadlineNode {
+        explicit Poll(SharedStopper& owner) noexcept:
+            DeadlineNode {},
+            stopper {owner}
+        {}
+
+        void onDeadline() noexcept override { stopper.pollState(); }
+
+        SharedStopper& stopper;
+    };
+
+    /// Map the state from `fd`, growing the file if needed, and close `fd`.
+    bool mapFd(int fd) noexcept;
+
+    /// Propagate expirations between the stopper and the bound scope, and
+    /// schedule the next poll.
+    void pollState() noexcept;
+
+    /// Return the current steady clock time in nanoseconds.
+    static std::int64_t steadyNow() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// The state of unshared stoppers.
+    static inline SharedStopperState unshared_state {};
+
+    /** \name Data members */
+    //@{
+    /// The shared state, or `unshared_state`.
+    SharedStopperState* state;
+
+    /// Whether `state` is a mapping of ours.
+    bool mapped;
+
+    /// Schedules the polls in the watchdog.
+    Poll poll;
+
+    /// Cleared by unbind(), so a running poll does not schedule again.
+    std::atomic<bool> bound;
+
+    /// The bound scope, or nullptr.
+    StopScope* bound_scope;
+
+    /// Id of the process that bound the scope.
+    int bound_pid;
+
+    /// Time between polls, in nanoseconds.
+    std::int64_t poll_interval;
+
+    /// The run of the shared state in the last poll.
+    std::uint32_t bound_run;
+
+    /// Whether the bound scope and the shared state were expired in the
+    /// last poll, to propagate only changes.
+    bool scope_was_expired;
+    bool state_was_expired;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//-----------------------------[ Shared memory ]------------------------------//
+
+inline bool SharedStopper::create() noexcept {
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    close();
+    void* memory = ::mmap(nullptr, sizeof(SharedStopperState),
+                          PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                          -1, 0);
+    if(memory == MAP_FAILED)
+        return false;
+    state = ::new(memory) SharedStopperState {};
+    mapped = true;
+    reset();
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+inline bool SharedStopper::create(const char* name) noexcept {
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    close();
+    if(!mapFd(::shm_open(name, O_RDWR | O_CREAT, 0600)))
+        return false;
+    reset();
+    return true;
+    #else
+    (void) name;
+    return false;
+    #endif
+}
+
+inline bool SharedStopper::open(const char* name) noexcept {
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    close();
+    return mapFd(::shm_open(name, O_RDWR, 0600));
+    #else
+    (void) name;
+    return false;
+    #endif
+}
+
+inline bool SharedStopper::openFile(const char* path) noexcept {
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    close();
+    return mapFd(::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600));
+    #else
+    (void) path;
+    return false;
+    #endif
+}
+
+inline bool SharedStopper::mapFd(int fd) noexcept {
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    if(fd == -1)
+        return false;
+
+    // Zeros, the valid initial state, fill a new or short file.
+    struct stat status {};
+    bool ok = ::fstat(fd, &status) == 0;
+    if(ok && status.st_size < static_cast<::off_t>(sizeof(SharedStopperState)))
+        ok = ::ftruncate(fd, sizeof(SharedStopperState)) == 0;
+
+    void* memory = ok? ::mmap(nullptr, sizeof(SharedStopperState),
+                              PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                     : MAP_FAILED;
+    ::close(fd);
+    if(memory == MAP_FAILED)
+        return false;
+    state = static_cast<SharedStopperState*>(memory);
+    mapped = true;
+    return true;
+    #else
+    (void) fd;
+    return false;
+    #endif
+}
+
+inline void SharedStopper::close() noexcept {
+    unbind();
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    if(mapped)
+        ::munmap(state, sizeof(SharedStopperState));
+    #endif
+    state = &unshared_state;
+    mapped = false;
+}
+
+inline bool SharedStopper::unlink(const char* name) noexcept {
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    return ::shm_unlink(name) == 0;
+    #else
+    (void) name;
+    return false;
+    #endif
+}
+
+//-------------------------------[ Expiration ]-------------------------------//
+
+inline void SharedStopper::expire() noexcept {
+    if(!mapped)
+        return;
+    if(state->expired.exchange(1, std::memory_order_relaxed) == 0) {
+        #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+        state->expired_by.store(::getpid(), std::memory_order_relaxed);
+        #endif
+    }
+}
+
+inline void SharedStopper::reset() noexcept {
+    if(!mapped)
+        return;
+    state->deadline.store(0, std::memory_order_relaxed);
+    state->expired_by.store(0, std::memory_order_relaxed);
+    state->expired.store(0, std::memory_order_relaxed);
+    state->run.fetch_add(1, std::memory_order_release);
+}
+
+//--------------------------------[ Deadline ]--------------------------------//
+
+inline void SharedStopper::setExpirationTime(
+    std::chrono::nanoseconds expiration_time) noexcept
+{
+    if(!mapped)
+        return;
+    const auto now = steadyNow();
+    const auto left = std::max(expiration_time.count(), std::int64_t {1});
+    state->deadline.store(
+        left > std::numeric_limits<std::int64_t>::max() - now?
+        std::int64_t {0} : now + left,
+        std::memory_order_relaxed);
+}
+
+inline std::chrono::nanoseconds SharedStopper::remaining() const noexcept {
+    const auto deadline = state->deadline.load(std::memory_order_relaxed);
+    if(deadline == 0)
+        return std::chrono::nanoseconds::max();
+    return std::chrono::nanoseconds {
+        std::max(deadline - steadyNow(), std::int64_t {0})};
+}
+
+inline bool SharedStopper::checkDeadline() noexcept {
+    if(!isExpired() && remaining() == std::chrono::nanoseconds {0})
+        expire();
+    return isExpired();
+}
+
+//--------------------------------[ Binding ]---------------------------------//
+
+inline void SharedStopper::bind(StopScope& scope,
+                                std::chrono::nanoseconds interval) noexcept {
+    unbind();
+    if(!mapped)
+        return;
+    bound_scope = &scope;
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    bound_pid = ::getpid();
+    #endif
+    poll_interval = std::max(interval.count(), DeadlineService::tick);
+    bound_run = state->run.load(std::memory_order_acquire);
+    scope_was_expired = scope.isExpired();
+    state_was_expired = isExpired();
+    bound.store(true, std::memory_order_release);
+    DeadlineService::instance().schedule(poll, DeadlineService::now());
+}
+
+inline void SharedStopper::unbind() noexcept {
+    if(bound_scope == nullptr)
+        return;
+    bound.store(false, std::memory_order_release);
+    // A forked child has a copy of the node, but not the watchdog. cancel()
+    // waits for a running poll, so the scope is not used afterwards.
+    #if defined(CEA_TIMER_HAS_SHARED_MEMORY)
+    if(bound_pid == ::getpid())
+    #endif
+        DeadlineService::instance().cancel(poll);
+    bound_scope = nullptr;
+}
+
+inline void SharedStopper::pollState() noexcept {
+    if(!bound.load(std::memory_order_acquire))
+        return;
+
+    const bool scope_expired = bound_scope->isExpired();
+    if(scope_expired && !scope_was_expired)
+        expire();
+    scope_was_expired = scope_expired;
+
+    // After a reset(), the stopper may have expired again since the last
+    // poll.
+    const auto run = state->run.load(std::memory_order_acquire);
+    if(run != bound_run) {
+        bound_run = run;
+        state_was_expired = false;
+    }
+    const bool state_expired = checkDeadline();
+    if(state_expired && !state_was_expired)
+        bound_scope->expire();
+    state_was_expired = state_expired;
+
+    // The stop callbacks of the scope may have unbound the stopper.
+    if(bound.load(std::memory_order_acquire))
+        DeadlineService::instance().schedule(poll,
+            DeadlineService::now() + poll_interval);
+}
+
+} // end of namespace cea
@@ -0,0 +1,648 @@
+/******************************************************************************
+ * @file stop_scope.hpp
+ * @brief Interface for the StopScope class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/clocks.hpp"
+#include "timer/concurrent_timer.hpp"
+#include "timer/deadline_service.hpp"
+#include "timer/notification_fd.hpp"
+#include "timer/timer.hpp"
+#include "timer/virtual_clock.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <vector>
+
+namespace cea {
+
+class ExpiryAwaiter;
+
+/**
+ * \brief StopScope class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * An instantiable cancellation scope with its own timer and time budget.
+ * Scopes can be nested: a child scope expires when its own deadline passes,
+ * when it is explicitly expired, or when its parent expires. For instance,
+ * each request in a service can have its own budget, which also expires when
+ * the global budget (the ExecutionStopper root scope) or Ctrl-C fires.
+ *
+ * Expiration is pushed down the tree when it happens, so isExpired() is
+ * a single relaxed atomic load no matter how deep the scope is. Deadlines are
+ * served by the process-wide DeadlineService thread; no thread is created per
+ * scope. As in ExecutionStopper, extending or clearing the deadline is a
+ * single atomic store; only bringing it forward touches the service.
+ *
+ * Threads that would otherwise sleep-poll isExpired() can block on
+ * waitFor() or waitUntilExpired() instead; they are woken up as soon as the
+ * scope expires. Event loops blocked in `poll()`/`epoll_wait()` can include
+ * expiryFd() in their wait set instead. Coroutines can `co_await expired()` or
+ * `co_await sleepFor(duration)`, and code built on `std::stop_token` can use
+ * stopToken(); both are served by the same DeadlineService thread.
+ *
+ * The scope's timer and deadlines run on VirtualClock, which follows the
+ * steady clock unless a test freezes it.
+ *
+ * A scope must outlive its children. Like ExecutionStopper, the timer
+ * controls (start/stop/resume/setExpirationTime) are meant to be called by a
+ * single controller thread, while any thread can query the scope.
+ */
+class StopScope: private DeadlineNode {
+public:
+    /** \name Constructors and destructor */
+    //@{
+    /// Build a root scope, without parent and without deadline.
+    StopScope();
+
+    /**
+     * \brief Build a child scope.
+     * \param parent the parent scope. If it is already expired, the child is
+     *        created expired.
+     */
+    explicit StopScope(StopScope& parent);
+
+    StopScope(const StopScope&) = delete;
+    StopScope& operator=(const StopScope&) = delete;
+    ~StopScope() override;
+    //@}
+
+    /** Timer manipulation */
+    //@{
+    /// Start the timer. It also resets the expiration, unless the parent
+    /// is expired.
+    void start() noexcept;
+
+    /// Stop the timer.
+    void stop() noexcept;
+
+    /// Resume the timer.
+    void resume() noexcept;
+
+    /**
+     * \brief Set the expiration time to stop.
+     * \param new_expiration_time the time budget, measured by this scope's
+     *        timer.
+     *
+     * If the timer is already running, the deadline is reprogrammed.
+     */
+    void setExpirationTime(
+        std::chrono::nanoseconds new_expiration_time
+    ) noexcept;
+
+    /// Expire this scope and all its descendants right away.
+    void expire() noexcept;
+    //@}
+
+    /** Time retrieval */
+    //@{
+    /// Returns the elapsed time in seconds.
+    std::chrono::seconds elapsed() const noexcept {
+        return timer.elapsed();
+    }
+
+    /// Returns the elapsed time in nanoseconds.
+    std::chrono::nanoseconds elapsedInNanoseconds() const noexcept {
+        return timer.elapsedInNanoseconds();
+    }
+
+    /**
+     * \brief Returns the approximate elapsed time in nanoseconds.
+     *
+     * Uses the coarse timestamp published by the DeadlineService instead of
+     * reading the clock, so it is only a few atomic loads, but it lags the
+     * exact value by about a millisecond (see DeadlineService::coarseNow()).
+     */
+    std::chrono::nanoseconds elapsedApprox() const noexcept {
+        return timer.elapsedInNanosecondsAt(VirtualClock::time_point {
+            std::chrono::nanoseconds {DeadlineService::coarseNow()}});
+    }
+
+    /// Return true if the timer has been stopped.
+    bool isStopped() const noexcept {
+        return timer.isStopped();
+    }
+
+    /// Indicate whether this scope or any of its ancestors expired.
+    bool isExpired() const noexcept {
+        return expired_flag.load(std::memory_order_relaxed);
+    }
+
+    /// Return the parent scope, or nullptr for a root scope.
+    StopScope* parent() const noexcept {
+        return parent_scope;
+    }
+    //@}
+
+    /** Waiting */
+    //@{
+    /**
+     * \brief Block until the scope expires or the timeout elapses.
+     * \param timeout maximum time to wait.
+     * \return true if the scope expired, false on timeout.
+     */
+    template <class Rep, class Period>
+    bool waitFor(const std::chrono::duration<Rep, Period>& timeout) {
+        if(isExpired())
+            return true;
+        std::unique_lock lock(mutex);
+        return expiry_cv.wait_for(lock, timeout, [this] {
+            return isExpired();
+        });
+    }
+
+    /// Block until the scope expires.
+    void waitUntilExpired() {
+        if(isExpired())
+            return;
+        std::unique_lock lock(mutex);
+        expiry_cv.wait(lock, [this] { return isExpired(); });
+    }
+
+    /**
+     * \brief Return a file descriptor that becomes readable on expiration.
+     *
+     * The descriptor (an eventfd on Linux, a pipe on other POSIX systems) is
+     * created on the first call, and owned by the scope. It stays readable
+     * while the scope is expired; start() makes it unreadable again. Event
+     * loops can add it to their `poll()`/`epoll_wait()` set, so expiry is
+     * part of the same wait, with no extra polling. Return -1 on systems
+     * without file descriptors.
+     */
+    int expiryFd() noexcept;
+    //@}
+
+    /** Coroutines and stop tokens */
+    //@{
+    /**
+     * \brief Return a stop token that is stopped when the scope expires.
+     *
+     * Stop callbacks run in the thread that expires the scope (usually the
+     * DeadlineService thread), so they must be short. Tokens are tied to the
+     * current run: once stopped, they stay stopped, and start() hands out
+     * new ones.
+     */
+    std::stop_token stopToken();
+
+    /**
+     * \brief Return an awaitable that resumes when the scope expires.
+     *
+     * `co_await scope.expired()` completes right away if the scope is already
+     * expired. Otherwise, the coroutine is resumed from the thread that
+     * expires the scope, just like the stop callbacks.
+     */
+    ExpiryAwaiter expired() noexcept;
+
+    /**
+     * \brief Return an awaitable that resumes after the given duration, or
+     *        earlier, if the scope expires.
+     * \param duration time to sleep.
+     *
+     * `co_await scope.sleepFor(duration)` gives true if the scope expired, and
+     * false if the whole duration elapsed, like waitFor(). The coroutine is
+     * resumed from the DeadlineService thread, or from the thread that
+     * expires the scope.
+     */
+    ExpiryAwaiter sleepFor(std::chrono::nanoseconds duration) noexcept;
+    //@}
+
+protected:
+    /** \name Internals */
+    //@{
+    /// Called by the DeadlineService when the deadline is (or was) reached.
+    void onDeadline() noexcept override;
+
+    /// Program the deadline for the remaining time.
+    void armDeadline() noexcept;
+
+    /// Clear the deadline.
+    void disarmDeadline() noexcept;
+
+    /// Expire this scope and its descendants, and collect the stop sources
+    /// to stop once unlocked. Requires the mutex to be held.
+    void expireLocked(std::vector<std::stop_source>& sources) noexcept;
+
+    /// Stop the collected sources. Their callbacks may do anything with the
+    /// scopes, even destroy them, so no lock is held and no scope is touched.
+    static void requestStop(std::vector<std::stop_source>& sources) noexcept {
+        for(auto& source : sources)
+            source.request_stop();
+    }
+    //@}
+
+    /** \name Data members */
+    //@{
+    /// The parent scope, or nullptr for a root scope.
+    StopScope* const parent_scope;
+
+    /// The time budget; nanoseconds::max() means no deadline.
+    std::chrono::nanoseconds expiration_time;
+
+    /// The timer. It is read from any thread, so it must be concurrent. It
+    /// runs on the DeadlineService time, so tests can drive it with
+    /// VirtualClock.
+    BasicConcurrentTimer<VirtualClock> timer;
+
+    /// Indicates expiration (own deadline, explicit, or from an ancestor).
+    /// It is read by every thread, all the time, so it has a cache line of
+    /// its own: writes to the members around it do not invalidate it.
+    alignas(cache_line_size) std::atomic<bool> expired_flag;
+
+    /// Deadline, in DeadlineService time (or DeadlineService::no_deadline).
+    alignas(cache_line_size) std::atomic<std::int64_t> deadline;
+
+    /// Guards the children list and serializes expiration with start().
+    std::mutex mutex;
+
+    /// Notified when the scope expires.
+    std::condition_variable expiry_cv;
+
+    /// Readable while the scope is expired, once expiryFd() is called.
+    NotificationFd expiry_fd;
+
+    /// Stopped on expiration, once stopToken() is called.
+    std::stop_source expiry_source;
+
+    /// Child scopes, notified on expiration.
+    std::vector<StopScope*> children;
+    //@}
+};
+
+/**
+ * \brief ExpiryAwaiter class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * The awaitable returned by StopScope::expired() and StopScope::sleepFor().
+ * It waits for the stop token of the scope and, for sleeps, for its own
+ * deadline in the DeadlineService, resuming the coroutine on whichever comes
+ * first. No thread is created per awaiter. `co_await` gives true if the scope
+ * expired.
+ */
+class ExpiryAwaiter: private DeadlineNode {
+public:
+    /** \name Constructor and destructor */
+    //@{
+    ExpiryAwaiter(const ExpiryAwaiter&) = delete;
+    ExpiryAwaiter& operator=(const ExpiryAwaiter&) = delete;
+    ~ExpiryAwaiter() override;
+    //@}
+
+    /** \name Awaitable interface */
+    //@{
+    bool await_ready() const noexcept;
+    bool await_suspend(std::coroutine_handle<> awaiting) noexcept;
+
+    bool await_resume() const noexcept {
+        return scope.isExpired();
+    }
+    //@}
+
+private:
+    friend class StopScope;
+
+    /// Stop callback resuming the awaiter.
+    struct Resumer {
+        ExpiryAwaiter* awaiter;
+        void operator()() const noexcept {
+            awaiter->fire();
+        }
+    };
+
+    /// Build an awaiter on the scope, with an optional deadline.
+    ExpiryAwaiter(StopScope& awaited_scope,
+                  std::int64_t awaiter_deadline) noexcept:
+        DeadlineNode {},
+        scope {awaited_scope},
+        deadline {awaiter_deadline},
+        handle {},
+        state {0},
+        stop_callback {}
+    {}
+
+    /// Called by the DeadlineService when the sleep is over.
+    void onDeadline() noexcept override;
+
+    /// Resume the coroutine, unless someone else already did it.
+    void fire() noexcept;
+
+    /** \name State bits */
+    //@{
+    /// The coroutine is suspended and waiting for fire().
+    static constexpr unsigned suspended_bit = 1;
+
+    /// fire() was called.
+    static constexpr unsigned fired_bit = 2;
+    //@}
+
+    /** \name Data members */
+    //@{
+    /// The scope being waited.
+    StopScope& scope;
+
+    /// Deadline, in DeadlineService time (or DeadlineService::no_deadline).
+    const std::int64_t deadline;
+
+    /// The awaiting coroutine.
+    std::coroutine_handle<> handle;
+
+    /// Combination of suspended_bit and fired_bit.
+    std::atomic<unsigned> state;
+
+    /// Registered on the scope's stop token while suspended.
+    std::optional<std::stop_callback<Resumer>> stop_callback;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//-----------------------[ Constructors and Destructor ]-----------------------//
+
+inline StopScope::StopScope():
+    DeadlineNode {},
+    parent_scope {nullptr},
+    expiration_time {std::chrono::nanoseconds::max()},
+    timer {},
+    expired_flag {false},
+    deadline {DeadlineService::no_deadline},
+    mutex {},
+    expiry_cv {},
+    expiry_fd {},
+    expiry_source {std::nostopstate},
+    children {}
+{
+    // Make sure the service is constructed first, so it is destroyed after
+    // any static scope.
+    DeadlineService::instance();
+}
+
+inline StopScope::StopScope(StopScope& parent):
+    DeadlineNode {},
+    parent_scope {&parent},
+    expiration_time {std::chrono::nanoseconds::max()},
+    timer {},
+    expired_flag {false},
+    deadline {DeadlineService::no_deadline},
+    mutex {},
+    expiry_cv {},
+    expiry_fd {},
+    expiry_source {std::nostopstate},
+    children {}
+{
+    DeadlineService::instance();
+    std::lock_guard lock(parent.mutex);
+    parent.children.push_back(this);
+    expired_flag.store(parent.isExpired(), std::memory_order_relaxed);
+}
+
+inline StopScope::~StopScope() {
+    DeadlineService::instance().cancel(*this);
+    if(parent_scope != nullptr) {
+        std::lock_guard lock(parent_scope->mutex);
+        auto& siblings = parent_scope->children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this),
+                       siblings.end());
+    }
+}
+
+//---------------------------[ Deadline management ]--------------------------//
+
+inline void StopScope::armDeadline() noexcept {
+    // Budgets beyond ~292 years (nanoseconds::max()) mean no deadline.
+    if(expiration_time == std::chrono::nanoseconds::max()) {
+        disarmDeadline();
+        return;
+    }
+
+    // Compute remaining time until deadline.
+    const auto remaining = expiration_time - timer.elapsedInNanoseconds();
+
+    // Already expired.
+    if(remaining <= std::chrono::nanoseconds {0}) {
+        disarmDeadline();
+        expire();
+        return;
+    }
+
+    // Saturate instead of overflowing for very long budgets.
+    const auto now = DeadlineService::now();
+    const auto new_deadline =
+        (remaining.count() >= DeadlineService::no_deadline - now)?
+        DeadlineService::no_deadline - 1 : now + remaining.count();
+
+    // Extending the deadline is a single atomic exchange: the service fires
+    // at the old deadline, and onDeadline() schedules the new one. Only a
+    // deadline brought forward (or a new one) needs the service.
+    const auto old_deadline =
+        deadline.exchange(new_deadline, std::memory_order_acq_rel);
+    if(new_deadline < old_deadline)
+        DeadlineService::instance().schedule(*this, new_deadline);
+}
+
+inline void StopScope::disarmDeadline() noexcept {
+    // The service fires at the old deadline and finds nothing to do.
+    deadline.store(DeadlineService::no_deadline, std::memory_order_release);
+}
+
+inline void StopScope::onDeadline() noexcept {
+    auto current = deadline.load(std::memory_order_acquire);
+    for(;;) {
+        if(current == DeadlineService::no_deadline)
+            return;
+
+        // The deadline was extended: sleep again.
+        if(DeadlineService::now() < current) {
+            DeadlineService::instance().schedule(*this, current);
+            return;
+        }
+
+        // Expire only if nobody moved the deadline in the meantime. The
+        // mutex serializes this with start(), which resets the flag.
+        std::vector<std::stop_source> sources;
+        {
+            std::lock_guard lock(mutex);
+            if(!deadline.compare_exchange_strong(current,
+                                                 DeadlineService::no_deadline,
+                                                 std::memory_order_acq_rel))
+                continue;
+            expireLocked(sources);
+        }
+        // Stop callbacks may resume coroutines; run them unlocked.
+        requestStop(sources);
+        return;
+    }
+}
+
+//-------------------------------[ Expiration ]-------------------------------//
+
+inline void StopScope::expire() noexcept {
+    std::vector<std::stop_source> sources;
+    {
+        std::lock_guard lock(mutex);
+        expireLocked(sources);
+    }
+    // Stop callbacks may resume coroutines, or destroy the scopes; run them
+    // unlocked.
+    requestStop(sources);
+}
+
+inline void StopScope::expireLocked(
+    std::vector<std::stop_source>& sources) noexcept
+{
+    disarmDeadline();
+    expired_flag.store(true, std::memory_order_relaxed);
+    expiry_cv.notify_all();
+    expiry_fd.notify();
+    // The copies keep the stop states alive if the scopes are destroyed.
+    if(expiry_source.stop_possible())
+        sources.push_back(expiry_source);
+    // Push the expiration down, so that checks stay a single load. Children
+    // leave the list under our lock, so they are alive while we hold it.
+    for(auto* child : children) {
+        std::lock_guard lock(child->mutex);
+        child->expireLocked(sources);
+    }
+}
+
+inline int StopScope::expiryFd() noexcept {
+    std::lock_guard lock(mutex);
+    if(!expiry_fd.isOpen() && expiry_fd.open() && isExpired())
+        expiry_fd.notify();
+    return expiry_fd.fd();
+}
+
+//-----------------------[ Coroutines and stop tokens ]-----------------------//
+
+inline std::stop_token StopScope::stopToken() {
+    std::lock_guard lock(mutex);
+    if(!expiry_source.stop_possible()) {
+        expiry_source = std::stop_source {};
+        if(isExpired())
+            expiry_source.request_stop();
+    }
+    return expiry_source.get_token();
+}
+
+inline ExpiryAwaiter StopScope::expired() noexcept {
+    return ExpiryAwaiter {*this, DeadlineService::no_deadline};
+}
+
+inline ExpiryAwaiter StopScope::sleepFor(
+    std::chrono::nanoseconds duration) noexcept
+{
+    // Saturate instead of overflowing for very long sleeps.
+    const auto now = DeadlineService::now();
+    const auto sleep = std::max(duration.count(), std::int64_t {0});
+    return ExpiryAwaiter {*this,
+        (sleep >= DeadlineService::no_deadline - now)?
+        DeadlineService::no_deadline - 1 : now + sleep};
+}
+
+inline ExpiryAwaiter::~ExpiryAwaiter() {
+    if(deadline != DeadlineService::no_deadline)
+        DeadlineService::instance().cancel(*this);
+}
+
+inline bool ExpiryAwaiter::await_ready() const noexcept {
+    return scope.isExpired() ||
+           (deadline != DeadlineService::no_deadline &&
+            DeadlineService::now() >= deadline);
+}
+
+inline bool ExpiryAwaiter::await_suspend(
+    std::coroutine_handle<> awaiting) noexcept
+{
+    handle = awaiting;
+    stop_callback.emplace(scope.stopToken(), Resumer {this});
+    if(deadline != DeadlineService::no_deadline)
+        DeadlineService::instance().schedule(*this, deadline);
+
+    // If fire() was called during the setup, it left the resumption to us:
+    // do not suspend. Otherwise, from now on, fire() resumes the coroutine.
+    const auto previous =
+        state.fetch_or(suspended_bit, std::memory_order_acq_rel);
+    return (previous & fired_bit) == 0;
+}
+
+inline void ExpiryAwaiter::onDeadline() noexcept {
+    if(DeadlineService::now() < deadline) {
+        DeadlineService::instance().schedule(*this, deadline);
+        return;
+    }
+    fire();
+}
+
+inline void ExpiryAwaiter::fire() noexcept {
+    // Only the first call resumes, and only once the coroutine is suspended.
+    // The awaiter may be destroyed by the resumed coroutine, so it is not
+    // touched afterwards.
+    const auto previous = state.fetch_or(fired_bit, std::memory_order_acq_rel);
+    if(previous == suspended_bit)
+        handle.resume();
+}
+
+//--------------------------[ Timer manipulation ]----------------------------//
+
+inline void StopScope::start() noexcept {
+    {
+        std::lock_guard lock(mutex);
+        disarmDeadline();
+        const bool parent_expired =
+            parent_scope != nullptr && parent_scope->isExpired();
+        expired_flag.store(parent_expired, std::memory_order_relaxed);
+        if(!parent_expired) {
+            expiry_fd.drain();
+            // Stopped tokens cannot be reset; hand out new ones.
+            if(expiry_source.stop_requested())
+                expiry_source = std::stop_source {std::nostopstate};
+        }
+    }
+    timer.start();
+    if(!isExpired())
+        armDeadline();
+}
+
+inline void StopScope::stop() noexcept {
+    timer.stop();
+    disarmDeadline();
+}
+
+inline void StopScope::resume() noexcept {
+    // If already expired, nothing to resume.
+    if(isExpired())
+        return;
+    timer.resume();
+    armDeadline();
+}
+
+inline void StopScope::setExpirationTime(
+    std::chrono::nanoseconds new_expiration_time) noexcept
+{
+    expiration_time = new_expiration_time;
+    // If the timer is running, reprogram the deadline.
+    if(!timer.isStopped())
+        armDeadline();
+}
+
+} // end of namespace cea
@@ -0,0 +1,457 @@
+/******************************************************************************
+ * @file task_pool.hpp
+ * @brief Interface for the TaskPool class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/clocks.hpp"
+#include "timer/execution_stopper.hpp"
+#include "timer/stop_scope.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cea {
+
+/**
+ * \brief ParallelProgress class.
+ *
+ * How much of a parallel loop ran before its scope expired.
+ */
+struct ParallelProgress {
+    /// Iterations that ran.
+    std::size_t completed {0};
+
+    /// Iterations in the loop.
+    std::size_t total {0};
+
+    /// Return true if every iteration ran.
+    bool isComplete() const noexcept {
+        return completed == total;
+    }
+};
+
+/**
+ * \brief ParallelResult class.
+ *
+ * The result of a parallel reduction over the iterations that ran, and how
+ * many they were.
+ */
+template <class T>
+struct ParallelResult: ParallelProgress {
+    /// The reduction of the iterations that ran.
+    T value {};
+};
+
+/**
+ * \brief TaskPool class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A work-stealing thread pool whose scheduler checks a StopScope (by
+ * default, the ExecutionStopper) between tasks. Once the scope expires, the
+ * queued tasks are dropped, and the parallel loops return what was done:
+ *
+ * \code
+ *     cea::ExecutionStopper::setExpirationTime(std::chrono::seconds {60});
+ *     cea::ExecutionStopper::start();
+ *     cea::TaskPool pool;
+ *
+ *     const auto best = pool.parallelReduce(std::size_t {0}, num_starts,
+ *         Solution {},
+ *         [&](std::size_t start) { return localSearch(start); },
+ *         [](const Solution& a, const Solution& b) {
+ *             return a.cost <= b.cost? a : b;
+ *         });
+ *     // The best solution of the `best.completed` searches that ran
+ *     // within the budget.
+ * \endcode
+ *
+ * The loops split their range into chunks of `grain` iterations, one task
+ * each. A task that started runs to its end, so the grain bounds how long
+ * the pool takes to stop after the expiration; with the default grain, each
+ * thread gets about 16 chunks. The reductions of the chunks that ran are
+ * combined in the order of the range, so the result does not depend on the
+ * scheduling when `combine` is associative.
+ *
+ * Each thread has its own deque of tasks: it takes the newest of its own,
+ * and steals the oldest of the others when it has none. The thread that
+ * calls a loop runs tasks too while it waits, so loops can be nested inside
+ * tasks. Tasks must not throw.
+ */
+class TaskPool {
+public:
+    /** \name Constructor and destructor */
+    //@{
+    /**
+     * \brief Start the worker threads.
+     * \param num_threads the number of workers; the thread calling a loop
+     *        takes part as well. Zero means one per hardware thread.
+     * \param stop_scope the scope checked between tasks.
+     */
+    explicit TaskPool(unsigned num_threads = 0,
+                      const StopScope& stop_scope = ExecutionStopper::root());
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /// Stop and join the worker threads.
+    ~TaskPool();
+    //@}
+
+    /** \name Parallel loops */
+    //@{
+    /**
+     * \brief Call `body(i)` for each `i` in `[first, last)`, in parallel,
+     *        until the scope expires.
+     * \param grain iterations per task; zero to pick one.
+     * \return the iterations that ran.
+     */
+    template <class Index, class Body>
+    ParallelProgress parallelFor(Index first, Index last, Body&& body,
+                                 std::size_t grain = 0);
+
+    /**
+     * \brief Reduce `map(i)` for each `i` in `[first, last)` with
+     *        `combine`, in parallel, until the scope expires.
+     * \param identity the value of an empty reduction.
+     * \param grain iterations per task; zero to pick one.
+     * \return the reduction of the iterations that ran, and their number.
+     */
+    template <class Index, class T, class Map, class Combine>
+    ParallelResult<T> parallelReduce(Index first, Index last, T identity,
+                                     Map&& map, Combine&& combine,
+                                     std::size_t grain = 0);
+    //@}
+
+    /** \name Queries */
+    //@{
+    /// Return the number of worker threads.
+    std::size_t numThreads() const noexcept {
+        return workers.size();
+    }
+
+    /// Return the number of tasks dropped on expiration, since built.
+    std::size_t numDropped() const noexcept {
+        return num_dropped.load(std::memory_order_relaxed);
+    }
+    //@}
+
+protected:
+    /// The tasks of a loop that did not finish or were not dropped yet.
+    /// Guarded by a mutex rather than an atomic, so the last task is done
+    /// with the group before the waiting loop returns and destroys it.
+    struct TaskGroup {
+        std::mutex mutex {};
+        std::condition_variable done {};
+        std::size_t pending {0};
+    };
+
+    /// A chunk of a loop.
+    struct Task {
+        std::function<void()> function;
+        TaskGroup* group;
+    };
+
+    /// The deque of a thread, on its own cache lines.
+    struct alignas(cache_line_size) TaskQueue {
+        std::mutex mutex {};
+        std::deque<Task> tasks {};
+    };
+
+    /// The pool and queue of the calling thread, if it is a worker.
+    struct WorkerSlot {
+        const TaskPool* pool {nullptr};
+        std::size_t index {0};
+    };
+
+    /// Return the slot of the calling thread.
+    static WorkerSlot& workerSlot() noexcept {
+        thread_local WorkerSlot slot;
+        return slot;
+    }
+
+    /// Return the grain for `total` iterations.
+    std::size_t pickGrain(std::size_t total, std::size_t grain) const noexcept {
+        const auto chunks = 16 * (workers.size() + 1);
+        return grain > 0? grain : std::max(total / chunks, std::size_t {1});
+    }
+
+    /// Queue the tasks of a loop.
+    void submit(std::vector<Task>& new_tasks);
+
+    /// Run the tasks of the group, and help with others, until none is
+    /// pending.
+    void wait(TaskGroup& group);
+
+    /// Take a task: the newest of queue `index`, or the oldest of another.
+    /// Drop all of them if the scope expired.
+    std::optional<Task> take(std::size_t index);
+
+    /// Drop the queued tasks of all queues.
+    void dropAll();
+
+    /// Mark a task of `group` as done or dropped.
+    static void finish(TaskGroup& group) {
+        std::lock_guard lock(group.mutex);
+        if(--group.pending == 0)
+            group.done.notify_all();
+    }
+
+    /// Body of worker `index`.
+    void workerLoop(std::size_t index);
+
+    /** \name Data members */
+    //@{
+    /// The scope checked between tasks.
+    const StopScope* scope;
+
+    /// One queue per worker.
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+
+    /// Tasks in the queues.
+    std::atomic<std::size_t> num_queued;
+
+    /// Tasks dropped since built.
+    std::atomic<std::size_t> num_dropped;
+
+    /// Queue of the next task submitted from outside the pool.
+    std::atomic<std::size_t> next_queue;
+
+    /// Guards the sleep of idle workers.
+    std::mutex sleep_mutex;
+
+    /// Wakes idle workers up when tasks are queued, or on shutdown.
+    std::condition_variable sleep_cv;
+
+    /// Asks the workers to finish.
+    bool shutdown;
+
+    /// The worker threads.
+    std::vector<std::thread> workers;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//----------------------[ Constructor and destructor ]------------------------//
+
+inline TaskPool::TaskPool(unsigned num_threads,
+                          const StopScope& stop_scope):
+    scope {&stop_scope},
+    queues {},
+    num_queued {0},
+    num_dropped {0},
+    next_queue {0},
+    sleep_mutex {},
+    sleep_cv {},
+    shutdown {false},
+    workers {}
+{
+    if(num_threads == 0)
+        num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    for(unsigned i = 0; i < num_threads; ++i)
+        queues.push_back(std::make_unique<TaskQueue>());
+    for(unsigned i = 0; i < num_threads; ++i)
+        workers.emplace_back([this, i] { workerLoop(i); });
+}
+
+inline TaskPool::~TaskPool() {
+    {
+        std::lock_guard lock(sleep_mutex);
+        shutdown = true;
+    }
+    sleep_cv.notify_all();
+    for(auto& worker : workers)
+        worker.join();
+}
+
+//----------------------------[ Parallel loops ]------------------------------//
+
+template <class Index, class Body>
+ParallelProgress TaskPool::parallelFor(Index first, Index last, Body&& body,
+                                       std::size_t grain) {
+    ParallelProgress progress;
+    progress.total = first < last? static_cast<std::size_t>(last - first) : 0;
+    grain = pickGrain(progress.total, grain);
+
+    std::atomic<std::size_t> completed {0};
+    TaskGroup group;
+    std::vector<Task> tasks;
+    for(std::size_t begin = 0; begin < progress.total; begin += grain) {
+        const auto end = std::min(begin + grain, progress.total);
+        tasks.push_back({[&, begin, end] {
+            for(auto i = begin; i < end; ++i)
+                body(static_cast<Index>(first + static_cast<Index>(i)));
+            completed.fetch_add(end - begin, std::memory_order_relaxed);
+        }, &group});
+    }
+    group.pending = tasks.size();
+    submit(tasks);
+    wait(group);
+
+    progress.completed = completed.load(std::memory_order_relaxed);
+    return progress;
+}
+
+template <class Index, class T, class Map, class Combine>
+ParallelResult<T> TaskPool::parallelReduce(Index first, Index last,
+                                           T identity, Map&& map,
+                                           Combine&& combine,
+                                           std::size_t grain) {
+    ParallelResult<T> result;
+    result.total = first < last? static_cast<std::size_t>(last - first) : 0;
+    result.value = identity;
+    grain = pickGrain(result.total, grain);
+
+    // One slot per chunk, filled only if the chunk ran.
+    const auto num_chunks = (result.total + grain - 1) / grain;
+    std::vector<std::optional<T>> partials(num_chunks);
+    TaskGroup group;
+    std::vector<Task> tasks;
+    for(std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        const auto begin = chunk * grain;
+        const auto end = std::min(begin + grain, result.total);
+        tasks.push_back({[&, chunk, begin, end] {
+            T value = identity;
+            for(auto i = begin; i < end; ++i)
+                value = combine(std::move(value),
+                    map(static_cast<Index>(first + static_cast<Index>(i))));
+            partials[chunk].emplace(std::move(value));
+        }, &group});
+    }
+    group.pending = tasks.size();
+    submit(tasks);
+    wait(group);
+
+    for(std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        if(!partials[chunk])
+            continue;
+        result.value = combine(std::move(result.value),
+                               std::move(*partials[chunk]));
+        const auto begin = chunk * grain;
+        result.completed += std::min(begin + grain, result.total) - begin;
+    }
+    return result;
+}
+
+//------------------------------[ Scheduling ]--------------------------------//
+
+inline void TaskPool::submit(std::vector<Task>& new_tasks) {
+    if(new_tasks.empty())
+        return;
+
+    // Workers queue on their own deque, for the others to steal; other
+    // threads spread the tasks over all deques.
+    const auto& slot = workerSlot();
+    const bool is_worker = slot.pool == this;
+    num_queued.fetch_add(new_tasks.size(), std::memory_order_relaxed);
+    for(auto& task : new_tasks) {
+        const auto index = is_worker? slot.index :
+            next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        auto& queue = *queues[index];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    // Taking the lock orders the count above before the wait predicate of
+    // workers about to sleep, so none misses the notification.
+    {
+        std::lock_guard lock(sleep_mutex);
+    }
+    sleep_cv.notify_all();
+}
+
+inline std::optional<TaskPool::Task> TaskPool::take(std::size_t index) {
+    if(scope->isExpired()) {
+        dropAll();
+        return std::nullopt;
+    }
+    if(num_queued.load(std::memory_order_relaxed) == 0)
+        return std::nullopt;
+
+    for(std::size_t offset = 0; offset < queues.size(); ++offset) {
+        auto& queue = *queues[(index + offset) % queues.size()];
+        std::lock_guard lock(queue.mutex);
+        if(queue.tasks.empty())
+            continue;
+        // The newest task of our own queue, the oldest of the others.
+        auto task = std::move(offset == 0? queue.tasks.back() :
+                                           queue.tasks.front());
+        if(offset == 0)
+            queue.tasks.pop_back();
+        else
+            queue.tasks.pop_front();
+        num_queued.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+    return std::nullopt;
+}
+
+inline void TaskPool::dropAll() {
+    for(auto& queue : queues) {
+        std::deque<Task> dropped;
+        {
+            std::lock_guard lock(queue->mutex);
+            dropped.swap(queue->tasks);
+        }
+        if(dropped.empty())
+            continue;
+        num_queued.fetch_sub(dropped.size(), std::memory_order_relaxed);
+        num_dropped.fetch_add(dropped.size(), std::memory_order_relaxed);
+        for(auto& task : dropped)
+            finish(*task.group);
+    }
+}
+
+inline void TaskPool::wait(TaskGroup& group) {
+    const auto& slot = workerSlot();
+    const auto index = slot.pool == this? slot.index : 0;
+    while(auto task = take(index)) {
+        task->function();
+        finish(*task->group);
+    }
+
+    // The tasks of the group left are running in other threads. Those that
+    // they queue are taken by the workers.
+    std::unique_lock lock(group.mutex);
+    group.done.wait(lock, [&group] { return group.pending == 0; });
+}
+
+inline void TaskPool::workerLoop(std::size_t index) {
+    workerSlot() = WorkerSlot {this, index};
+    for(;;) {
+        if(auto task = take(index)) {
+            task->function();
+            finish(*task->group);
+            continue;
+        }
+        std::unique_lock lock(sleep_mutex);
+        sleep_cv.wait(lock, [this] {
+            return shutdown || num_queued.load(std::memory_order_relaxed) > 0;
+        });
+        if(shutdown)
+            return;
+    }
+}
+
+} // end of namespace cea
@@ -6,7 +6,7 @@
  * SPDX-License-Identifier: BSD-3-Clause.
  *
  * Created on : 2015-06-17 by ceandrade.
- * Last update: 2026-07-26 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
  ******************************************************************************/
 
 #pragma once
@@ -18,7 +18,7 @@ namespace cea {
 using namespace std::chrono;
 
 /**
- * \brief Timer class.
+ * \brief BasicTimer class.
  *
  * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
  * \date 2026
@@ -26,13 +26,24 @@ using namespace std::chrono;
  * This class is a simple timer partially cloned from Boost::timer.
  * The objective is to have a steady wallclock-only timer without
  * a Boost dependency.
+ *
+ * The clock is a policy: any type satisfying the standard `Clock`
+ * requirements (`duration`, `time_point`, and a static `now()`) can be used.
+ * `std::chrono::steady_clock` is the default, and `Timer` is an alias for it.
+ * Cheaper clocks for hot loops are available in `timer/clocks.hpp`.
+ *
+ * \tparam Clock the clock policy used to read the current time.
  */
-class Timer {
+template <class Clock = steady_clock>
+class BasicTimer {
 public:
+    /// The clock policy used by this timer.
+    using clock = Clock;
+
     /** \name Constructor and destructor */
     //@{
     /// Default Constructor.
-    Timer(): start_time {}, time_duration {0}, is_stopped {true} {}
+    BasicTimer(): start_time {}, time_duration {0}, is_stopped {true} {}
     //@}
 
 public:
@@ -42,7 +53,7 @@ public:
     void start() noexcept {
         is_stopped = false;
         time_duration = nanoseconds {0};
-        start_time = steady_clock::now();
+        start_time = Clock::now();
     }
 
     /// Stop the timer.
@@ -50,14 +61,14 @@ public:
         if(is_stopped)
             return;
         is_stopped = true;
-        time_duration += steady_clock::now() - start_time;
+        time_duration += duration_cast<nanoseconds>(Clock::now() - start_time);
     }
 
     /// Resume the timer.
     void resume() noexcept {
         if(!is_stopped)
             return;
-        start_time = steady_clock::now();
+        start_time = Clock::now();
         is_stopped = false;
     }
     //@}
@@ -68,7 +79,9 @@ public:
     std::chrono::nanoseconds elapsedInNanoseconds() const noexcept {
         if(is_stopped)
             return time_duration;
-        const auto delta = (steady_clock::now() - start_time) + time_duration;
+        const auto delta =
+            duration_cast<nanoseconds>(Clock::now() - start_time) +
+            time_duration;
         return delta;
     }
 
@@ -87,7 +100,7 @@ protected:
     /** \name Data members */
     //@{
     /// Holds thow much time has passed between timer starts and stops.
-    time_point<steady_clock> start_time;
+    typename Clock::time_point start_time;
 
     /// Holds how much time has passed between timer starts and stops.
     nanoseconds time_duration;
@@ -96,4 +109,8 @@ protected:
     bool is_stopped;
     //@}
 };
+
+/// The default timer, based on `std::chrono::steady_clock`.
+using Timer = BasicTimer<steady_clock>;
+
 } // end of namespace cea
@@ -0,0 +1,421 @@
+/******************************************************************************
+ * @file timing_wheel.hpp
+ * @brief Interface for the TimingWheel class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace cea {
+
+/**
+ * \brief TimingWheelNode class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Intrusive node of a TimingWheel. Objects to be scheduled derive from (or
+ * contain) a node, so that insertion and removal never allocate.
+ */
+class TimingWheelNode {
+public:
+    /** \name Constructor and destructor */
+    //@{
+    TimingWheelNode() = default;
+    TimingWheelNode(const TimingWheelNode&) = delete;
+    TimingWheelNode& operator=(const TimingWheelNode&) = delete;
+    //@}
+
+    /// Return true if the node is in a wheel (scheduled or expired).
+    bool isLinked() const noexcept {
+        return prev != nullptr;
+    }
+
+    /// Return the expiration tick. Valid while linked.
+    std::int64_t expiryTick() const noexcept {
+        return expiry;
+    }
+
+private:
+    friend class TimingWheel;
+
+    /// Circular doubly-linked list links; nullptr when not linked.
+    TimingWheelNode* prev {nullptr};
+    TimingWheelNode* next {nullptr};
+
+    /// Expiration tick.
+    std::int64_t expiry {0};
+
+    /// Slot holding the node (level * num_slots + slot), or the expired list.
+    std::uint32_t slot_id {0};
+};
+
+/**
+ * \brief TimingWheel class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A hierarchical timing wheel (Varghese & Lauck) holding any number of
+ * TimingWheelNodes, keyed by integer ticks. It has `num_levels` levels of
+ * `num_slots` slots each; level `L` holds nodes expiring between
+ * `num_slots^L` and `num_slots^(L+1)` ticks ahead, and its slots are cascaded
+ * down to the lower levels as time advances. Nodes further than the top
+ * level's range are parked in the top level and cascaded again later.
+ *
+ * Insertion and removal are O(1). Advancing the wheel costs O(1) per expired
+ * or cascaded node: one bitmap per level lets the wheel jump directly to the
+ * next tick with work to do, so idle periods cost nothing.
+ *
+ * The wheel is not thread-safe; the owner must synchronize access.
+ */
+class TimingWheel {
+public:
+    /** \name Geometry */
+    //@{
+    /// Number of bits to index the slots of a level.
+    static constexpr unsigned slot_bits = 8;
+
+    /// Number of slots per level.
+    static constexpr unsigned num_slots = 1u << slot_bits;
+
+    /// Number of levels.
+    static constexpr unsigned num_levels = 4;
+
+    /// Number of ticks covered by the wheel.
+    static constexpr std::int64_t range =
+        std::int64_t {1} << (slot_bits * num_levels);
+
+    /// Tick value meaning "no tick".
+    static constexpr std::int64_t no_tick =
+        std::numeric_limits<std::int64_t>::max();
+    //@}
+
+    /** \name Constructor and destructor */
+    //@{
+    /// Build an empty wheel whose current time is `start_tick`.
+    explicit TimingWheel(std::int64_t start_tick = 0) noexcept;
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    /// Unlink all the nodes still in the wheel.
+    ~TimingWheel();
+    //@}
+
+    /** \name Scheduling */
+    //@{
+    /**
+     * \brief Insert a node in O(1).
+     * \param node a node not linked to any wheel.
+     * \param tick the expiration tick. Ticks not after the current one
+     *        go straight to the expired list.
+     */
+    void insert(TimingWheelNode& node, std::int64_t tick) noexcept;
+
+    /// Remove a linked node in O(1), including from the expired list.
+    void remove(TimingWheelNode& node) noexcept;
+
+    /**
+     * \brief Advance the current time to `tick`.
+     *
+     * Nodes expiring until `tick` move to the expired list, where they can be
+     * taken by popExpired().
+     */
+    void advance(std::int64_t tick) noexcept;
+
+    /// Take a node from the expired list, or return nullptr if empty.
+    TimingWheelNode* popExpired() noexcept;
+    //@}
+
+    /** \name Queries */
+    //@{
+    /// Return the current tick.
+    std::int64_t currentTick() const noexcept {
+        return current;
+    }
+
+    /**
+     * \brief Return the next tick at which advance() has work to do.
+     *
+     * This is either a node expiration or a cascade. Return `current` if the
+     * expired list is not empty, and `no_tick` if the wheel is empty.
+     */
+    std::int64_t nextEventTick() const noexcept;
+
+    /// Return the number of nodes in the wheel, including the expired ones.
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    /// Return true if the wheel holds no nodes.
+    bool empty() const noexcept {
+        return count == 0;
+    }
+    //@}
+
+protected:
+    /** \name Internals */
+    //@{
+    /// Link the node at the given slot, after `head`'s last node.
+    void link(TimingWheelNode& node, std::uint32_t slot_id) noexcept;
+
+    /// Place a node according to its expiry and the current tick.
+    void place(TimingWheelNode& node) noexcept;
+
+    /// Re-place all the nodes of a slot.
+    void cascade(unsigned level, unsigned slot) noexcept;
+
+    /// Move the expired nodes of a level-0 slot to the expired list.
+    void expireSlot(unsigned slot) noexcept;
+
+    /// Return the next expiration or cascade tick, ignoring expired nodes.
+    std::int64_t nextWheelTick() const noexcept;
+
+    /**
+     * \brief Find the first occupied slot of a level, circularly.
+     * \return the distance (0 to num_slots - 1) from `start` to the first
+     *         occupied slot, or -1 if the level is empty.
+     */
+    int findOccupied(unsigned level, unsigned start) const noexcept;
+
+    /// Return the sentinel of a slot.
+    TimingWheelNode& head(std::uint32_t slot_id) noexcept {
+        return slot_id == expired_id? expired : slots[slot_id];
+    }
+    //@}
+
+    /// Slot id of the expired list.
+    static constexpr std::uint32_t expired_id = num_slots * num_levels;
+
+    /// Number of 64-bit words in the bitmap of a level.
+    static constexpr unsigned bitmap_words = num_slots / 64;
+
+    /** \name Data members */
+    //@{
+    /// List sentinels, level by level.
+    std::array<TimingWheelNode, num_slots * num_levels> slots;
+
+    /// One bit per non-empty slot, level by level.
+    std::array<std::array<std::uint64_t, bitmap_words>, num_levels> occupied;
+
+    /// Sentinel of the list of expired nodes.
+    TimingWheelNode expired;
+
+    /// Current tick.
+    std::int64_t current;
+
+    /// Number of nodes.
+    std::size_t count;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//------------------[ Default Constructor and Destructor ]--------------------//
+
+inline TimingWheel::TimingWheel(std::int64_t start_tick) noexcept:
+    slots {},
+    occupied {},
+    expired {},
+    current {start_tick},
+    count {0}
+{
+    for(auto& sentinel : slots)
+        sentinel.prev = sentinel.next = &sentinel;
+    expired.prev = expired.next = &expired;
+}
+
+inline TimingWheel::~TimingWheel() {
+    for(std::uint32_t id = 0; id <= expired_id; ++id) {
+        auto& sentinel = head(id);
+        for(auto* node = sentinel.next; node != &sentinel;) {
+            auto* next = node->next;
+            node->prev = node->next = nullptr;
+            node = next;
+        }
+    }
+}
+
+//------------------------------[ Internals ]---------------------------------//
+
+inline void TimingWheel::link(TimingWheelNode& node,
+                              std::uint32_t slot_id) noexcept {
+    auto& sentinel = head(slot_id);
+    node.slot_id = slot_id;
+    node.prev = sentinel.prev;
+    node.next = &sentinel;
+    sentinel.prev->next = &node;
+    sentinel.prev = &node;
+    if(slot_id != expired_id)
+        occupied[slot_id / num_slots][(slot_id % num_slots) / 64] |=
+            std::uint64_t {1} << (slot_id % 64);
+}
+
+inline void TimingWheel::place(TimingWheelNode& node) noexcept {
+    // Already due.
+    if(node.expiry <= current) {
+        link(node, expired_id);
+        return;
+    }
+
+    // Nodes beyond the wheel range are parked at the farthest top slot.
+    const auto delta = node.expiry - current;
+    const auto target = (delta < range)? node.expiry : current + range - 1;
+
+    unsigned level = 0;
+    while(level + 1 < num_levels &&
+          (target - current) >= (std::int64_t {1} << (slot_bits * (level + 1))))
+        ++level;
+
+    const auto slot = static_cast<std::uint32_t>(
+        (target >> (slot_bits * level)) & (num_slots - 1));
+    link(node, level * num_slots + slot);
+}
+
+inline void TimingWheel::cascade(unsigned level, unsigned slot) noexcept {
+    auto& sentinel = slots[level * num_slots + slot];
+    auto* node = sentinel.next;
+    sentinel.prev = sentinel.next = &sentinel;
+    occupied[level][slot / 64] &= ~(std::uint64_t {1} << (slot % 64));
+
+    while(node != &sentinel) {
+        auto* next = node->next;
+        place(*node);
+        node = next;
+    }
+}
+
+inline void TimingWheel::expireSlot(unsigned slot) noexcept {
+    auto& sentinel = slots[slot];
+    auto* node = sentinel.next;
+    sentinel.prev = sentinel.next = &sentinel;
+    occupied[0][slot / 64] &= ~(std::uint64_t {1} << (slot % 64));
+
+    while(node != &sentinel) {
+        auto* next = node->next;
+        if(node->expiry <= current)
+            link(*node, expired_id);
+        else
+            place(*node);
+        node = next;
+    }
+}
+
+inline int TimingWheel::findOccupied(unsigned level,
+                                     unsigned start) const noexcept {
+    const auto& bits = occupied[level];
+    // Scan the words from `start`, wrapping around once.
+    for(unsigned i = 0; i <= bitmap_words; ++i) {
+        const unsigned word = ((start / 64) + i) % bitmap_words;
+        auto mask = bits[word];
+        if(i == 0)
+            mask &= ~std::uint64_t {0} << (start % 64);
+        else if(i == bitmap_words)
+            mask &= ~(~std::uint64_t {0} << (start % 64));
+        if(mask != 0) {
+            const unsigned slot = word * 64 +
+                static_cast<unsigned>(std::countr_zero(mask));
+            return static_cast<int>((slot + num_slots - start) % num_slots);
+        }
+    }
+    return -1;
+}
+
+//-----------------------------[ Scheduling ]---------------------------------//
+
+inline void TimingWheel::insert(TimingWheelNode& node,
+                                std::int64_t tick) noexcept {
+    node.expiry = tick;
+    place(node);
+    ++count;
+}
+
+inline void TimingWheel::remove(TimingWheelNode& node) noexcept {
+    if(!node.isLinked())
+        return;
+
+    node.prev->next = node.next;
+    node.next->prev = node.prev;
+    const auto id = node.slot_id;
+    if(id != expired_id) {
+        const auto& sentinel = slots[id];
+        if(sentinel.next == &sentinel)
+            occupied[id / num_slots][(id % num_slots) / 64] &=
+                ~(std::uint64_t {1} << (id % 64));
+    }
+    node.prev = node.next = nullptr;
+    --count;
+}
+
+inline TimingWheelNode* TimingWheel::popExpired() noexcept {
+    auto* node = expired.next;
+    if(node == &expired)
+        return nullptr;
+    remove(*node);
+    return node;
+}
+
+inline std::int64_t TimingWheel::nextEventTick() const noexcept {
+    if(count == 0)
+        return no_tick;
+    if(expired.next != &expired)
+        return current;
+    return nextWheelTick();
+}
+
+inline std::int64_t TimingWheel::nextWheelTick() const noexcept {
+    auto next = no_tick;
+    for(unsigned level = 0; level < num_levels; ++level) {
+        // Level 0 slots expire at their tick; the slots of the upper levels
+        // are cascaded when all the lower-level bits of the tick are zero.
+        const auto shift = slot_bits * level;
+        const auto base = current >> shift;
+        const auto start =
+            static_cast<unsigned>((base + 1) & (num_slots - 1));
+        const int distance = findOccupied(level, start);
+        if(distance < 0)
+            continue;
+        const auto tick = (base + 1 + distance) << shift;
+        if(tick < next)
+            next = tick;
+    }
+    return next;
+}
+
+inline void TimingWheel::advance(std::int64_t tick) noexcept {
+    for(;;) {
+        const auto next = nextWheelTick();
+        if(next > tick)
+            break;
+        current = next;
+
+        // Cascade the upper levels whose lower-level indices all wrapped.
+        for(unsigned level = 1; level < num_levels; ++level) {
+            const auto shift = slot_bits * level;
+            if((current & ((std::int64_t {1} << shift) - 1)) != 0)
+                break;
+            cascade(level,
+                    static_cast<unsigned>((current >> shift) & (num_slots - 1)));
+        }
+
+        expireSlot(static_cast<unsigned>(current & (num_slots - 1)));
+    }
+    if(tick > current)
+        current = tick;
+}
+
+} // end of namespace cea
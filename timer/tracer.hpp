@@ -0,0 +1,530 @@
+/******************************************************************************
+ * @file tracer.hpp
+ * @brief Interface for the Tracer class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/clocks.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER)
+    /// Keeps a function out of its callers, for cold paths.
+    #define CEA_TIMER_NOINLINE __declspec(noinline)
+#else
+    /// Keeps a function out of its callers, for cold paths.
+    #define CEA_TIMER_NOINLINE __attribute__((noinline))
+#endif
+
+namespace cea {
+
+/// A trace event, as recorded by the producer threads.
+struct TraceEvent {
+    /// Name of the event, usually a string literal.
+    const char* name;
+
+    /// Category of the event, usually a string literal.
+    const char* category;
+
+    /// When the event happened, in TscClock nanoseconds.
+    std::int64_t timestamp;
+
+    /// Chrome trace phase: 'B' (begin), 'E' (end), or 'i' (instant).
+    char phase;
+};
+
+/**
+ * \brief TraceBuffer class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A single-producer, single-consumer ring buffer of trace events. The
+ * producer is the thread that owns the buffer, and the consumer is the
+ * Tracer's flusher. The producer never blocks: when the buffer is full,
+ * the event is dropped and counted.
+ */
+class TraceBuffer {
+public:
+    /// Number of events the buffer holds. A power of two.
+    static constexpr std::size_t capacity = std::size_t {1} << 13;
+
+    /** \name Constructor and destructor */
+    //@{
+    /// Build an empty buffer for the given thread id.
+    explicit TraceBuffer(std::uint32_t id) noexcept:
+        write_index {0},
+        cached_read_index {0},
+        dropped_events {0},
+        read_index {0},
+        thread_id {id},
+        events {}
+    {}
+
+    TraceBuffer(const TraceBuffer&) = delete;
+    TraceBuffer& operator=(const TraceBuffer&) = delete;
+    //@}
+
+    /** \name Producer */
+    //@{
+    /// Append an event. Return false, dropping it, if the buffer is full.
+    bool push(const TraceEvent& event) noexcept {
+        const auto head = write_index.load(std::memory_order_relaxed);
+        if(head - cached_read_index >= capacity) [[unlikely]] {
+            cached_read_index = read_index.load(std::memory_order_acquire);
+            if(head - cached_read_index >= capacity) {
+                dropped_events.store(
+                    dropped_events.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+                return false;
+            }
+        }
+        events[head & (capacity - 1)] = event;
+        write_index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    //@}
+
+    /** \name Consumer */
+    //@{
+    /// Hand every pending event to `consume`. Return how many there were.
+    template <class Consumer>
+    std::size_t drain(Consumer consume) {
+        const auto tail = read_index.load(std::memory_order_relaxed);
+        const auto head = write_index.load(std::memory_order_acquire);
+        for(auto index = tail; index != head; ++index)
+            consume(events[index & (capacity - 1)]);
+        read_index.store(head, std::memory_order_release);
+        return static_cast<std::size_t>(head - tail);
+    }
+
+    /// Return the id of the owner thread in the trace.
+    std::uint32_t threadId() const noexcept { return thread_id; }
+
+    /// Return the number of events dropped because the buffer was full.
+    std::uint64_t droppedEvents() const noexcept {
+        return dropped_events.load(std::memory_order_relaxed);
+    }
+    //@}
+
+protected:
+    /** \name Producer side, on a cache line of its own */
+    //@{
+    alignas(cache_line_size) std::atomic<std::uint64_t> write_index;
+
+    /// The producer's last view of read_index, to avoid touching its line.
+    std::uint64_t cached_read_index;
+
+    std::atomic<std::uint64_t> dropped_events;
+    //@}
+
+    /** \name Consumer side, on a cache line of its own */
+    //@{
+    alignas(cache_line_size) std::atomic<std::uint64_t> read_index;
+    //@}
+
+    /// Id of the owner thread in the trace.
+    const std::uint32_t thread_id;
+
+    /// The ring itself.
+    std::array<TraceEvent, capacity> events;
+};
+
+/**
+ * \brief Tracer class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * Timeline traces in the Chrome trace-event JSON format, which both
+ * `chrome://tracing` and the Perfetto UI (https://ui.perfetto.dev) open:
+ *
+ * \code
+ *     cea::Tracer::start("solver.json");
+ *     // ... ProfileRegion's and ExecutionStopper events are recorded ...
+ *     cea::Tracer::stop();
+ * \endcode
+ *
+ * While tracing, profiling regions (see BasicProfiler) record begin and end
+ * events, and the ExecutionStopper records its start, stop, resume,
+ * expiration, and signals as instant events. Other events can be recorded
+ * with begin(), end(), and instant().
+ *
+ * Each thread records into a TraceBuffer of its own, so recording takes no
+ * lock: a clock read, a few stores, and a release store to publish the
+ * event. It never blocks either: if the flusher falls behind and the buffer
+ * fills up, the event is dropped and counted (see droppedEvents()). Only
+ * the first event of each thread takes a lock, to register its buffer. When
+ * tracing is off, recording is a single relaxed load.
+ *
+ * A background flusher thread drains the buffers every `flush_period` and
+ * streams the events to the output, so traces can be longer than the
+ * buffers. Buffers of finished threads are drained before being released.
+ *
+ * Event names and categories must outlive the trace; string literals are
+ * the intended use.
+ */
+class Tracer {
+public:
+    /** \name Trace control */
+    //@{
+    /**
+     * \brief Start tracing into a file.
+     * \return false if tracing is already on or the file cannot be opened.
+     */
+    static bool start(const std::string& path,
+                      std::chrono::milliseconds flush_period =
+                          std::chrono::milliseconds {10});
+
+    /**
+     * \brief Start tracing into a stream, which must outlive the trace.
+     * \return false if tracing is already on.
+     */
+    static bool start(std::ostream& output,
+                      std::chrono::milliseconds flush_period =
+                          std::chrono::milliseconds {10});
+
+    /// Stop tracing, writing the remaining events and closing the trace.
+    static void stop();
+
+    /// Return true while tracing.
+    static bool isEnabled() noexcept {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Return the number of events dropped because a buffer was full.
+    static std::uint64_t droppedEvents();
+    //@}
+
+    /** \name Recording (any thread) */
+    //@{
+    /// Record the beginning of a slice in the calling thread.
+    static void begin(const char* name, const char* category = "region")
+        noexcept {
+        record(name, category, 'B');
+    }
+
+    /// Record the end of a slice in the calling thread.
+    static void end(const char* name, const char* category = "region")
+        noexcept {
+        record(name, category, 'E');
+    }
+
+    /// Record an instant event in the calling thread.
+    static void instant(const char* name, const char* category) noexcept {
+        record(name, category, 'i');
+    }
+
+    /// Record the beginning of a region, at a time already read by the
+    /// caller. Saves a clock read in the profiler.
+    static void beginAt(const char* name, TscClock::time_point when)
+        noexcept {
+        recordAt(name, "region", 'B', when);
+    }
+
+    /// Record the end of a region, at a time already read by the caller.
+    static void endAt(const char* name, TscClock::time_point when) noexcept {
+        recordAt(name, "region", 'E', when);
+    }
+    //@}
+
+protected:
+    /** \name Private methods to avoid creation and copy */
+    //@{
+    Tracer();
+    ~Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+    //@}
+
+    /** \name Internals */
+    //@{
+    /// Return the singleton.
+    static Tracer& instance();
+
+    /// Record an event if tracing is on.
+    static void record(const char* name, const char* category, char phase)
+        noexcept {
+        if(isEnabled()) [[unlikely]]
+            push(name, category, phase, TscClock::now());
+    }
+
+    /// Record an event at the given time, if tracing is on.
+    static void recordAt(const char* name, const char* category, char phase,
+                         TscClock::time_point when) noexcept {
+        if(isEnabled()) [[unlikely]]
+            push(name, category, phase, when);
+    }
+
+    /// Append an event to the calling thread's buffer. Kept out of line, so
+    /// that the callers stay small when tracing is off.
+    CEA_TIMER_NOINLINE static void push(const char* name,
+                                        const char* category, char phase,
+                                        TscClock::time_point when) noexcept {
+        threadBuffer().push({name, category, when.time_since_epoch().count(),
+                             phase});
+    }
+
+    /// Return the calling thread's buffer, registering it on first use.
+    static TraceBuffer& threadBuffer() noexcept {
+        thread_local std::shared_ptr<TraceBuffer> buffer =
+            instance().registerThread();
+        return *buffer;
+    }
+
+    /// Create and register a buffer for a new thread.
+    std::shared_ptr<TraceBuffer> registerThread();
+
+    /// Start the trace, once the output is set. Call with the mutex held.
+    void startLocked(std::chrono::milliseconds period);
+
+    /// Drain the buffers into the output, every flush period.
+    void flushLoop();
+
+    /// Drain the buffers into the output. Call with the mutex held.
+    void flushLocked();
+
+    /// Write an event as a JSON object. Call with the mutex held.
+    void writeEvent(const TraceEvent& event, std::uint32_t thread_id);
+
+    /// Write a JSON string, escaped.
+    static void writeString(std::ostream& stream, const char* text);
+    //@}
+
+    /** \name Data members */
+    //@{
+    /// On while tracing.
+    static inline std::atomic<bool> enabled {false};
+
+    /// Guards everything below.
+    std::mutex mutex;
+
+    /// Wakes up the flusher early, on stop().
+    std::condition_variable flush_cv;
+
+    /// The buffers of all threads that recorded events.
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+
+    /// The output file, when tracing into a file.
+    std::ofstream file;
+
+    /// Where the trace is written.
+    std::ostream* output;
+
+    /// Timestamp of the start of the trace, the zero of the timeline.
+    std::int64_t origin;
+
+    /// Period between flushes.
+    std::chrono::milliseconds flush_period;
+
+    /// Id of the next thread to register.
+    std::uint32_t next_thread_id;
+
+    /// Events dropped by threads that already finished.
+    std::uint64_t finished_dropped;
+
+    /// True until the first event of the trace is written.
+    bool first_event;
+
+    /// Asks the flusher to finish.
+    bool stopping;
+
+    /// Drains the buffers in the background.
+    std::thread flusher;
+    //@}
+};
+
+//----------------------------------------------------------------------------//
+// Inline implementation (header-only).
+//----------------------------------------------------------------------------//
+
+//------------------[ Default Constructor and Destructor ]--------------------//
+
+inline Tracer::Tracer():
+    mutex {},
+    flush_cv {},
+    buffers {},
+    file {},
+    output {nullptr},
+    origin {0},
+    flush_period {10},
+    next_thread_id {1},
+    finished_dropped {0},
+    first_event {true},
+    stopping {false},
+    flusher {}
+{}
+
+inline Tracer::~Tracer() {
+    stop();
+}
+
+inline Tracer& Tracer::instance() {
+    static Tracer inst;
+    return inst;
+}
+
+inline std::shared_ptr<TraceBuffer> Tracer::registerThread() {
+    std::lock_guard lock(mutex);
+    buffers.push_back(std::make_shared<TraceBuffer>(next_thread_id++));
+    return buffers.back();
+}
+
+//-----------------------------[ Trace control ]------------------------------//
+
+inline bool Tracer::start(const std::string& path,
+                          std::chrono::milliseconds period) {
+    auto& tracer = instance();
+    std::lock_guard lock(tracer.mutex);
+    if(tracer.output != nullptr)
+        return false;
+    tracer.file.open(path);
+    if(!tracer.file)
+        return false;
+    tracer.output = &tracer.file;
+    tracer.startLocked(period);
+    return true;
+}
+
+inline bool Tracer::start(std::ostream& stream,
+                          std::chrono::milliseconds period) {
+    auto& tracer = instance();
+    std::lock_guard lock(tracer.mutex);
+    if(tracer.output != nullptr)
+        return false;
+    tracer.output = &stream;
+    tracer.startLocked(period);
+    return true;
+}
+
+inline void Tracer::startLocked(std::chrono::milliseconds period) {
+    // Events that raced with the last stop() do not belong to this trace.
+    for(auto& buffer : buffers)
+        buffer->drain([](const TraceEvent&) {});
+
+    origin = TscClock::now().time_since_epoch().count();
+    flush_period = period;
+    first_event = true;
+    stopping = false;
+    *output << "{\"traceEvents\":[";
+    enabled.store(true, std::memory_order_relaxed);
+    flusher = std::thread {[this] { flushLoop(); }};
+}
+
+inline void Tracer::stop() {
+    auto& tracer = instance();
+    {
+        std::lock_guard lock(tracer.mutex);
+        if(tracer.output == nullptr)
+            return;
+        enabled.store(false, std::memory_order_relaxed);
+        tracer.stopping = true;
+    }
+    tracer.flush_cv.notify_all();
+    tracer.flusher.join();
+
+    std::lock_guard lock(tracer.mutex);
+    tracer.flushLocked();
+    *tracer.output << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    tracer.output->flush();
+    if(tracer.file.is_open())
+        tracer.file.close();
+    tracer.output = nullptr;
+}
+
+inline std::uint64_t Tracer::droppedEvents() {
+    auto& tracer = instance();
+    std::lock_guard lock(tracer.mutex);
+    auto total = tracer.finished_dropped;
+    for(const auto& buffer : tracer.buffers)
+        total += buffer->droppedEvents();
+    return total;
+}
+
+//--------------------------------[ Flushing ]--------------------------------//
+
+inline void Tracer::flushLoop() {
+    std::unique_lock lock(mutex);
+    while(!stopping) {
+        flush_cv.wait_for(lock, flush_period, [this] { return stopping; });
+        flushLocked();
+    }
+}
+
+inline void Tracer::flushLocked() {
+    for(auto& buffer : buffers) {
+        const auto thread_id = buffer->threadId();
+        buffer->drain([this, thread_id](const TraceEvent& event) {
+            writeEvent(event, thread_id);
+        });
+    }
+
+    // The buffers only we hold belong to finished threads, and are drained.
+    const auto finished = std::remove_if(buffers.begin(), buffers.end(),
+        [this](const std::shared_ptr<TraceBuffer>& buffer) {
+            if(buffer.use_count() != 1)
+                return false;
+            finished_dropped += buffer->droppedEvents();
+            return true;
+        });
+    buffers.erase(finished, buffers.end());
+}
+
+inline void Tracer::writeEvent(const TraceEvent& event,
+                               std::uint32_t thread_id) {
+    auto& stream = *output;
+    const auto time = std::max(event.timestamp - origin, std::int64_t {0});
+
+    stream << (first_event? "\n" : ",\n") << "{\"name\":";
+    first_event = false;
+    writeString(stream, event.name);
+    stream << ",\"cat\":";
+    writeString(stream, event.category);
+    // Timestamps are in microseconds; keep the nanoseconds as decimals.
+    stream
+    << ",\"ph\":\"" << event.phase << "\""
+    << ",\"ts\":" << time / 1000 << '.'
+    << std::setw(3) << std::setfill('0') << time % 1000 << std::setfill(' ')
+    << ",\"pid\":1,\"tid\":" << thread_id;
+    if(event.phase == 'i')
+        stream << ",\"s\":\"t\"";
+    stream << '}';
+}
+
+inline void Tracer::writeString(std::ostream& stream, const char* text) {
+    stream << '"';
+    for(; *text != '\0'; ++text) {
+        const auto c = static_cast<unsigned char>(*text);
+        if(c == '"' || c == '\\')
+            stream << '\\' << *text;
+        else if(c < 0x20)
+            stream << "\\u00" << "0123456789abcdef"[c >> 4]
+                   << "0123456789abcdef"[c & 0xF];
+        else
+            stream << *text;
+    }
+    stream << '"';
+}
+
+} // end of namespace cea
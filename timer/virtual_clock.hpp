@@ -0,0 +1,106 @@
+/******************************************************************************
+ * @file virtual_clock.hpp
+ * @brief Interface for the VirtualClock class.
+ *
+ * SPDX-FileCopyrightText: 2015-2026 Carlos E. Andrade <ce.andrade@gmail.com>
+ * SPDX-License-Identifier: BSD-3-Clause.
+ *
+ * Created on : 2026-10-16 by ceandrade.
+ * Last update: 2026-10-16 by ceandrade.
+ ******************************************************************************/
+
+#pragma once
+
+#include "timer/deadline_service.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+
+namespace cea {
+
+/**
+ * \brief VirtualClock class.
+ *
+ * \author Carlos Eduardo de Andrade <ce.andrade@gmail.com>
+ * \date 2026
+ *
+ * A `std::chrono`-compatible clock that can be frozen and advanced by hand,
+ * so tests of time-budgeted code run instantly and give the same result
+ * every run:
+ *
+ * \code
+ *     cea::VirtualClock::enable();
+ *     cea::ExecutionStopper::setExpirationTime(5s);
+ *     cea::ExecutionStopper::start();
+ *     cea::VirtualClock::advance(4s);
+ *     assert(!cea::ExecutionStopper::isExpired());
+ *     cea::VirtualClock::advance(1s);
+ *     assert(cea::ExecutionStopper::isExpired());
+ * \endcode
+ *
+ * It is the clock of StopScope, ExecutionStopper, and the DeadlineService
+ * watchdog, and can be given to BasicTimer, BasicConcurrentTimer, and the
+ * other timers as a clock policy. Until enable() is called, it follows
+ * `steady_clock`. Once enabled, it stands still, and only advance() moves
+ * it; advance() returns after the watchdog fired everything due by then
+ * (expirations, stop callbacks, coroutine sleeps), so the test can check
+ * the outcome right away. disable() goes back to the steady clock,
+ * continuing from the virtual time, so the clock never goes backwards.
+ *
+ * Enabling happens at the current time rounded up to a DeadlineService tick
+ * (100 us), so budgets and advances in whole ticks line up exactly. Enable
+ * it before starting the timers and scopes that should use it. Waits with a
+ * timeout (`waitFor()`) keep running on real time. CPU-time budgets count
+ * the real CPU time, but the watchdog checks them on the virtual time: while
+ * frozen, a spent budget expires the stopper only when advance() reaches
+ * the next check.
+ */
+class VirtualClock {
+public:
+    /** \name Standard clock requirements */
+    //@{
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<VirtualClock>;
+    static constexpr bool is_steady = true;
+    //@}
+
+    /// Return the current time: the virtual time, if enabled, or the steady
+    /// clock.
+    static time_point now() noexcept {
+        return time_point {duration {DeadlineService::now()}};
+    }
+
+    /** \name Virtual time control */
+    //@{
+    /// Freeze the clock; from now on, only advance() moves it.
+    static void enable() noexcept {
+        DeadlineService::instance().enableVirtualTime();
+    }
+
+    /// Go back to the steady clock, continuing from the virtual time.
+    static void disable() noexcept {
+        DeadlineService::instance().disableVirtualTime();
+    }
+
+    /// Return true if the clock is frozen.
+    static bool isEnabled() noexcept {
+        return DeadlineService::isVirtualTime();
+    }
+
+    /**
+     * \brief Move the clock forward, and wait for the watchdog to fire all
+     *        deadlines up to the new time.
+     *
+     * Does nothing unless enabled. Must not be called from a deadline
+     * callback (such as a stop callback run on expiration).
+     */
+    static void advance(std::chrono::nanoseconds delta) noexcept {
+        DeadlineService::instance().advanceVirtualTime(delta.count());
+    }
+    //@}
+};
+
+} // end of namespace cea